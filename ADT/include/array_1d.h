@@ -16,12 +16,28 @@
  *
  * An element key of NULL is considered to be "no" key.
  *
+ * The high index limit can grow: array_1d_push() adds an element after
+ * the last one. The storage is then reallocated to twice its size when
+ * full, so a push takes amortized constant time.
+ *
+ * Ranges of positions can be filled, cleared and copied in bulk. An
+ * array_1d_slice_view() shares the storage of its array.
+ *
+ * An array created by array_1d_create_indexed() also keeps a bitmap of
+ * the positions with keys, so sparse arrays can be scanned quickly.
+ *
  * Authors: Niclas Borlin (niclas@cs.umu.se)
  *
  * Based on earlier code by: Johan Eliasson (johane@cs.umu.se).
  *
  * Version information:
  *   2018-01-28: v1.0, first public version.
+ *   2026-10-17: v1.1, added array_1d_push(), array_1d_reserve() and
+ *		 array_1d_shrink_to_fit().
+ *   2026-10-17: v1.2, added array_1d_fill(), array_1d_clear_range(),
+ *		 array_1d_copy_range() and array_1d_slice_view().
+ *   2026-10-17: v1.3, added array_1d_create_indexed(),
+ *		 array_1d_next_key() and array_1d_count_keys().
  */
 
 // ==========PUBLIC DATA TYPES============
@@ -46,6 +62,23 @@ typedef struct array_1d array_1d;
  */
 array_1d *array_1d_create(int lo, int hi, free_function free_func);
 
+/**
+ * array_1d_create_indexed() - Create an array with an occupancy index.
+ * @lo: low index limit.
+ * @hi: high index limit.
+ * @free_func: A pointer to a function (or NULL) to be called to
+ *	       de-allocate memory on remove/kill.
+ *
+ * As array_1d_create(), but the array also keeps one bit per position
+ * that tells if a key is set. array_1d_next_key(), array_1d_count_keys()
+ * and array_1d_kill() then look at 64 positions at a time, which pays
+ * off for sparse arrays.
+ *
+ * Returns: A pointer to the new array, or NULL if not enough memory
+ * was available.
+ */
+array_1d *array_1d_create_indexed(int lo, int hi, free_function free_func);
+
 /**
  * array_1d_low() - Return the low index limit for the array.
  * @a: array to inspect.
@@ -81,6 +114,29 @@ void *array_1d_inspect_key(const array_1d *a, int i);
  */
 bool array_1d_has_key(const array_1d *a, int i);
 
+/**
+ * array_1d_next_key() - Find the next position with a key.
+ * @a: array to inspect.
+ * @i: index to start at, low <= i <= high + 1.
+ *
+ * Can be used to visit the keys in index order:
+ *
+ *   for (i=array_1d_next_key(a, array_1d_low(a)); i<=array_1d_high(a);
+ *	  i=array_1d_next_key(a, i+1))
+ *
+ * Returns: The smallest index k >= i with a key set, or high + 1 if
+ * there is none.
+ */
+int array_1d_next_key(const array_1d *a, int i);
+
+/**
+ * array_1d_count_keys() - Count the positions with a key.
+ * @a: array to inspect.
+ *
+ * Returns: The number of positions with a key set.
+ */
+int array_1d_count_keys(const array_1d *a);
+
 /**
  * array_1d_set_key() - Set a key at a given array position.
  * @a: array to modify.
@@ -94,12 +150,116 @@ bool array_1d_has_key(const array_1d *a, int i);
  */
 void array_1d_set_key(array_1d *a, void *v, int i);
 
+/**
+ * array_1d_push() - Add a key after the last array position.
+ * @a: array to modify.
+ * @v: key to store at the new position, or NULL.
+ *
+ * Increases the high index limit by one and sets the key at the new
+ * high index. The low index limit is not changed.
+ *
+ * Returns: True, or false if not enough memory was available. The
+ * array is then unchanged.
+ */
+bool array_1d_push(array_1d *a, void *v);
+
+/**
+ * array_1d_reserve() - Make room for a number of elements.
+ * @a: array to modify.
+ * @n: number of elements to make room for.
+ *
+ * Allocates storage for at least n elements, so the array can be
+ * pushed to n elements without reallocating. The index limits are not
+ * changed.
+ *
+ * Returns: True, or false if not enough memory was available. The
+ * array is then unchanged.
+ */
+bool array_1d_reserve(array_1d *a, int n);
+
+/**
+ * array_1d_shrink_to_fit() - Return unused storage.
+ * @a: array to modify.
+ *
+ * Shrinks the storage to the elements between the index limits.
+ *
+ * Returns: Nothing.
+ */
+void array_1d_shrink_to_fit(array_1d *a);
+
+/**
+ * array_1d_fill() - Set the same key at a range of array positions.
+ * @a: array to modify.
+ * @v: key to set, or NULL.
+ * @i: first index of the range.
+ * @j: last index of the range.
+ *
+ * Sets the key v at all positions i <= k <= j. Any old keys in the
+ * range are de-allocated by the free_func, if specified. Since the
+ * same key is stored at every position, a non-NULL v should only be
+ * used if the array has no free_func or the range has one element.
+ *
+ * Returns: Nothing.
+ */
+void array_1d_fill(array_1d *a, void *v, int i, int j);
+
+/**
+ * array_1d_clear_range() - Remove the keys from a range of positions.
+ * @a: array to modify.
+ * @i: first index of the range.
+ * @j: last index of the range.
+ *
+ * Sets all positions i <= k <= j to "no" key. Any old keys in the
+ * range are de-allocated by the free_func, if specified.
+ *
+ * Returns: Nothing.
+ */
+void array_1d_clear_range(array_1d *a, int i, int j);
+
+/**
+ * array_1d_copy_range() - Copy keys from one array to another.
+ * @dst: array to copy to.
+ * @d: index in dst of the first copied key.
+ * @src: array to copy from.
+ * @i: index in src of the first key to copy.
+ * @j: index in src of the last key to copy.
+ *
+ * Sets the keys at src positions i..j at dst positions d..d+j-i. The
+ * key pointers are copied, not the keys themselves. Any old keys in
+ * the dst range are de-allocated by the free_func of dst, if
+ * specified. The arrays may be the same, with overlapping ranges,
+ * unless dst has a free_func.
+ *
+ * Returns: Nothing.
+ */
+void array_1d_copy_range(array_1d *dst, int d, const array_1d *src,
+			 int i, int j);
+
+/**
+ * array_1d_slice_view() - Create a view of a range of an array.
+ * @a: array to view.
+ * @i: low index limit of the view.
+ * @j: high index limit of the view.
+ *
+ * The view shares its storage with a, so no keys are copied, and
+ * uses the same indices as a. Keys set in the view are set in a. The
+ * view has no free_func and cannot grow. It must be killed with
+ * array_1d_kill() before a is killed, and becomes invalid if the
+ * storage of a is reallocated by array_1d_push(), array_1d_reserve()
+ * or array_1d_shrink_to_fit().
+ *
+ * Returns: A pointer to the view, or NULL if not enough memory was
+ * available.
+ */
+array_1d *array_1d_slice_view(const array_1d *a, int i, int j);
+
 /**
  * array_1d_kill() - Return memory allocated by array.
  * @a: array to kill.
  * 
  * Iterates over all elements. If free_func was specified at array
- * creation, calls it for every non-NULL element key.
+ * creation, calls it for every non-NULL element key. Killing a view
+ * only returns the view itself.
  *
  * Returns: Nothing.
  */
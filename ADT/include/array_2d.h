@@ -16,6 +16,11 @@
  *
  * An element key of NULL is considered to be "no" key.
  *
+ * The keys are stored with the first index varying fastest. An array
+ * created by array_2d_create_tiled() instead stores them in square
+ * tiles, which makes traversals along the second dimension as cheap
+ * as along the first.
+ *
  * Authors: Niclas Borlin (niclas@cs.umu.se)
  *
  * Based on earlier code by: Johan Eliasson (johane@cs.umu.se).
@@ -23,6 +28,8 @@
  * Version information:
  *   2018-01-28: v1.0, first public version.
  *   2018-04-03: v1.1, moved freehandler last in create parameter list.
+ *   2026-10-17: v1.2, added array_2d_create_tiled() and block
+ *		 iteration.
  */
 
 // ==========PUBLIC DATA TYPES============
@@ -30,6 +37,15 @@
 // List type.
 typedef struct array_2d array_2d;
 
+// Side of the tiles and blocks, in positions.
+#define ARRAY_2D_TILE 8
+
+// A block of positions, with inclusive index limits per dimension.
+typedef struct array_2d_block {
+	int low[2];
+	int high[2];
+} array_2d_block;
+
 // ==========DATA STRUCTURE INTERFACE==========
 
 /**
@@ -50,6 +66,26 @@ typedef struct array_2d array_2d;
 array_2d *array_2d_create(int lo1, int hi1, int lo2, int hi2,
                           free_function free_func);
 
+/**
+ * array_2d_create_tiled() - Create an array with tiled storage.
+ * @lo1: low index limit for first dimension.
+ * @hi1: high index limit for first dimension.
+ * @lo2: low index limit for second dimension.
+ * @hi2: high index limit for second dimension.
+ * @free_func: A pointer to a function (or NULL) to be called to
+ *	       de-allocate memory on remove/kill.
+ *
+ * As array_2d_create(), but the keys are stored in tiles of
+ * ARRAY_2D_TILE x ARRAY_2D_TILE positions. The keys of a tile are
+ * stored together, so a traversal along either dimension touches
+ * few cache lines, especially when done block by block.
+ *
+ * Returns: A pointer to the new array, or NULL if not enough memory
+ * was available.
+ */
+array_2d *array_2d_create_tiled(int lo1, int hi1, int lo2, int hi2,
+				free_function free_func);
+
 /**
  * array_2d_low() - Return the low index limit for the array.
  * @a: array to inspect.
@@ -103,6 +139,37 @@ bool array_2d_has_key(const array_2d *a, int i, int j);
  */
 void array_2d_set_key(array_2d *a, void *v, int i, int j);
 
+/**
+ * array_2d_block_begin() - Start a traversal of the array in blocks.
+ * @a: array to traverse.
+ * @b: block to initialize.
+ *
+ * The blocks cover the array in ARRAY_2D_TILE x ARRAY_2D_TILE
+ * positions, cut at the index limits. They match the tiles of a
+ * tiled array. Each block is set by array_2d_block_next().
+ *
+ * Returns: Nothing.
+ */
+void array_2d_block_begin(const array_2d *a, array_2d_block *b);
+
+/**
+ * array_2d_block_next() - Move to the next block of the array.
+ * @a: array to traverse.
+ * @b: block from array_2d_block_begin() or the previous call.
+ *
+ * Sets the index limits of b to the next block. The blocks are
+ * visited in storage order, first along the first dimension. Within
+ * a block, the first index should vary fastest:
+ *
+ *   array_2d_block_begin(a, &b);
+ *   while (array_2d_block_next(a, &b))
+ *	   for (j=b.low[1]; j<=b.high[1]; j++)
+ *		   for (i=b.low[0]; i<=b.high[0]; i++)
+ *
+ * Returns: True, or false if all blocks have been visited.
+ */
+bool array_2d_block_next(const array_2d *a, array_2d_block *b);
+
 /**
  * array_2d_kill() - Return memory allocated by array.
  * @a: array to kill.
@@ -0,0 +1,173 @@
+#ifndef __INT_ARRAY_2D_H
+#define __INT_ARRAY_2D_H
+
+#include <stdbool.h>
+#include "util.h"
+
+/*
+ * Declaration of an integer 2D array for the "Datastructures and
+ * algorithms" courses at the Department of Computing Science, Umea
+ * University. After use, the function int_array_2d_kill must be called
+ * to de-allocate the dynamic memory used by the array itself.
+ *
+ * An element key of 0 is considered to be "no" key.
+ *
+ * The keys are stored in one block with the first index varying
+ * fastest. Each column starts on a 32-byte boundary. The fill, add,
+ * min/max and sum functions work on whole arrays and use AVX2 when
+ * compiled with -mavx2, otherwise plain loops. They treat every
+ * position as a value, with 0 for "no" key.
+ *
+ * Version information:
+ *   2026-10-17: v1.0, first public version.
+ */
+
+// ==========PUBLIC DATA TYPES============
+
+// List type.
+typedef struct int_array_2d int_array_2d;
+
+// ==========DATA STRUCTURE INTERFACE==========
+
+/**
+ * int_array_2d_create() - Create an array without keys.
+ * @lo1: low index limit for first dimension.
+ * @hi1: high index limit for first dimension.
+ * @lo2: low index limit for second dimension.
+ * @hi2: high index limit for second dimension.
+ *
+ * The index limits are inclusive, i.e. all indices i such that low <=
+ * i <= high are defined.
+ *
+ * Returns: A pointer to the new array, or NULL if not enough memory
+ * was available.
+ */
+int_array_2d *int_array_2d_create(int lo1, int hi1, int lo2, int hi2);
+
+/**
+ * int_array_2d_low() - Return the low index limit for the array.
+ * @a: array to inspect.
+ * @d: dimension number, 1 or 2.
+ *
+ * Returns: The low index limit for dimension number d.
+ */
+int int_array_2d_low(const int_array_2d *a, int d);
+
+/**
+ * int_array_2d_high() - Return the high index limit for the array.
+ * @a: array to inspect.
+ * @d: dimension number, 1 or 2.
+ *
+ * Returns: The high index limit for dimension number d.
+ */
+int int_array_2d_high(const int_array_2d *a, int d);
+
+/**
+ * int_array_2d_inspect_key() - Inspect a key at a given array position.
+ * @a: array to inspect.
+ * @i: first index of position to inspect.
+ * @j: second index of position to inspect.
+ *
+ * Returns: The element key at the specified position, or 0 if no
+ *	    key is stored at that position.
+ */
+int int_array_2d_inspect_key(const int_array_2d *a, int i, int j);
+
+/**
+ * int_array_2d_has_key() - Check if a key is set at a given array position.
+ * @a: array to inspect.
+ * @i: first index of position to inspect.
+ * @j: second index of position to inspect.
+ *
+ * Returns: True if a key is set at the specified position, otherwise false.
+ */
+bool int_array_2d_has_key(const int_array_2d *a, int i, int j);
+
+/**
+ * int_array_2d_set_key() - Set a key at a given array position.
+ * @a: array to modify.
+ * @v: key to set element to, or 0 to clear key.
+ * @i: first index of position to modify.
+ * @j: second index of position to modify.
+ *
+ * Returns: Nothing.
+ */
+void int_array_2d_set_key(int_array_2d *a, int v, int i, int j);
+
+/**
+ * int_array_2d_fill() - Set all positions to the same key.
+ * @a: array to modify.
+ * @v: key to set, or 0 to clear all keys.
+ *
+ * Returns: Nothing.
+ */
+void int_array_2d_fill(int_array_2d *a, int v);
+
+/**
+ * int_array_2d_add() - Add an array to another, element by element.
+ * @a: array to modify.
+ * @b: array to add. Must have the same index limits as a.
+ *
+ * A sum that does not fit in an int wraps around modulo 2^32.
+ *
+ * Returns: Nothing.
+ */
+void int_array_2d_add(int_array_2d *a, const int_array_2d *b);
+
+/**
+ * int_array_2d_min() - Return the smallest key in the array.
+ * @a: array to inspect.
+ *
+ * Returns: The smallest key, or 0 if the array has no positions.
+ */
+int int_array_2d_min(const int_array_2d *a);
+
+/**
+ * int_array_2d_max() - Return the largest key in the array.
+ * @a: array to inspect.
+ *
+ * Returns: The largest key, or 0 if the array has no positions.
+ */
+int int_array_2d_max(const int_array_2d *a);
+
+/**
+ * int_array_2d_row_sums() - Sum the keys along the second dimension.
+ * @a: array to inspect.
+ * @sums: room for one sum per first index.
+ *
+ * Sets sums[i-lo1] to the sum of the keys at (i,j) over all j.
+ *
+ * Returns: Nothing.
+ */
+void int_array_2d_row_sums(const int_array_2d *a, long long *sums);
+
+/**
+ * int_array_2d_col_sums() - Sum the keys along the first dimension.
+ * @a: array to inspect.
+ * @sums: room for one sum per second index.
+ *
+ * Sets sums[j-lo2] to the sum of the keys at (i,j) over all i.
+ *
+ * Returns: Nothing.
+ */
+void int_array_2d_col_sums(const int_array_2d *a, long long *sums);
+
+/**
+ * int_array_2d_kill() - Return memory allocated by array.
+ * @a: array to kill.
+ *
+ * Returns: Nothing.
+ */
+void int_array_2d_kill(int_array_2d *a);
+
+/**
+ * int_array_2d_print() - Iterate over the array element and print their keys.
+ * @a: Array to inspect.
+ *
+ * Iterates over each position in the array. Prints each non-zero element.
+ *
+ * Returns: Nothing.
+ */
+void int_array_2d_print(const int_array_2d *a);
+
+#endif
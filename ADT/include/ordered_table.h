@@ -0,0 +1,76 @@
+#ifndef ORDERED_TABLE_H
+#define ORDERED_TABLE_H
+
+#include "table.h"
+
+/*
+ * Declaration of the ordered queries of a table kept sorted by key,
+ * for the "Datastructures and algorithms" courses at the Department
+ * of Computing Science, Umea University. Keys are ordered by the
+ * compare_function given at table creation. The table itself is
+ * created and used through table.h. Only table4.c implements these
+ * functions.
+ *
+ * All queries see one element per key. For a duplicate key, this is
+ * the last value added, as returned by table_lookup().
+ *
+ * Version information:
+ *   2026-10-17: v1.0, first public version.
+ */
+
+// ==========DATA STRUCTURE INTERFACE==========
+
+/**
+ * table_min() - Return the smallest key in a table.
+ * @t: Table to inspect.
+ *
+ * Returns: The smallest key stored in the table, or NULL if the table
+ * is empty.
+ */
+void *table_min(const table *t);
+
+/**
+ * table_max() - Return the largest key in a table.
+ * @t: Table to inspect.
+ *
+ * Returns: The largest key stored in the table, or NULL if the table
+ * is empty.
+ */
+void *table_max(const table *t);
+
+/**
+ * table_floor() - Find the largest key not greater than a given key.
+ * @t: Table to inspect.
+ * @key: Key to search for.
+ *
+ * Returns: The largest stored key that compares less than or equal to
+ * key, or NULL if there is none.
+ */
+void *table_floor(const table *t, const void *key);
+
+/**
+ * table_ceiling() - Find the smallest key not less than a given key.
+ * @t: Table to inspect.
+ * @key: Key to search for.
+ *
+ * Returns: The smallest stored key that compares greater than or
+ * equal to key, or NULL if there is none.
+ */
+void *table_ceiling(const table *t, const void *key);
+
+/**
+ * table_range() - Visit all key/value pairs in a key range.
+ * @t: Table to inspect.
+ * @lo: Smallest key to visit.
+ * @hi: Largest key to visit.
+ * @callback: Function called for each key/value pair with lo <= key
+ *	      <= hi, in increasing key order.
+ *
+ * Takes time proportional to log n plus the number of pairs visited.
+ *
+ * Returns: Nothing.
+ */
+void table_range(const table *t, const void *lo, const void *hi,
+		 inspect_callback_pair callback);
+
+#endif
@@ -2,22 +2,23 @@
 #define TABLE_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include "util.h"
 
 /*
  * Declaration of a generic table for the "Datastructures and
  * algorithms" courses at the Department of Computing Science, Umea
  * University. The table stores void pointers, so it can be used to
- * store all types of keys. After use, the function table_kill must
+ * store all types of values. After use, the function table_kill must
  * be called to de-allocate the dynamic memory used by the table
  * itself. The de-allocation of any dynamic memory allocated for the
- * key and/or key keys is the responsibility of the user of the
+ * keys and/or values is the responsibility of the user of the
  * table, unless a corresponding free_function is registered in
  * table_empty.
  *
  * Duplicates are handled by lookup and remove. Lookup will return
- * the last key added for a duplicate key. Remove will remove all
- * elements with matching keys. WARNING: If the key or key
+ * the last value added for a duplicate key. Remove will remove all
+ * elements with matching keys. WARNING: If the key or value
  * free_function is set, do not add the same pointer twice as this
  * will result in memory errors.
  *
@@ -28,12 +29,31 @@
  *
  * Version information:
  *   2018-02-06: v1.0, first public version.
+ *   2026-10-17: v1.1, added table_empty_hashed().
+ *   2026-10-17: v1.2, added table_from_arrays().
+ *   2026-10-17: v1.3, added table_iter and table_drain().
  */
 
 // ==========PUBLIC DATA TYPES============
 // Table type.
 typedef struct table table;
 
+// Depth of the position stack in a table_iter.
+#define TABLE_ITER_DEPTH 16
+
+/*
+ * A cursor over the key/value pairs of a table, set up by
+ * table_iter_begin(). It can live on the stack and is advanced without
+ * allocating. The fields are private to the table implementation.
+ */
+typedef struct table_iter {
+	const table *t;
+	void *pos[TABLE_ITER_DEPTH];
+	size_t idx[TABLE_ITER_DEPTH];
+	int depth;
+	void *next;
+} table_iter;
+
 // ==========DATA STRUCTURE INTERFACE==========
 
 /**
@@ -42,46 +62,93 @@ typedef struct table table;
  *                util.h for the definition of compare_function.
  * @key_free_func: A pointer to a function (or NULL) to be called to
  *		   de-allocate memory for keys on remove/kill.
- * @key_free_func: A pointer to a function (or NULL) to be called to
- *		     de-allocate memory for keys on remove/kill.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
  *
  * Returns: Pointer to a new table.
  */
 table *table_empty(compare_function key_cmp_func,
 		   free_function key_free_func,
-		   free_function key_free_func);
+		   free_function value_free_func);
+
+/**
+ * table_empty_hashed() - Create an empty table that may hash its keys.
+ * @key_cmp_func: A pointer to a function to be used to compare keys. See
+ *                util.h for the definition of compare_function.
+ * @key_hash_func: A pointer to a function (or NULL) to be used to hash
+ *		   keys. See util.h for the definition of hash_function.
+ * @key_free_func: A pointer to a function (or NULL) to be called to
+ *		   de-allocate memory for keys on remove/kill.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
+ *
+ * Implementations that do not hash keys ignore key_hash_func and
+ * behave as table_empty().
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty_hashed(compare_function key_cmp_func,
+			  hash_function key_hash_func,
+			  free_function key_free_func,
+			  free_function value_free_func);
+
+/**
+ * table_from_arrays() - Create a table holding n key/value pairs.
+ * @keys: Array of n key pointers.
+ * @values: Array of n value pointers.
+ * @n: Number of pairs.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_hash_func: A pointer to a function (or NULL) to be used to hash
+ *		   keys. Ignored by implementations that do not hash keys.
+ * @key_free_func: A pointer to a function (or NULL) to be called to
+ *		   de-allocate memory for keys on remove/kill.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
+ *
+ * Gives the same table as inserting the pairs with table_insert() in
+ * array order, so a later duplicate key takes precedence. Storage is
+ * allocated once for all n pairs. Only the pointers are copied from
+ * the arrays, which may be freed afterwards.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_from_arrays(void **keys, void **values, int n,
+			 compare_function key_cmp_func,
+			 hash_function key_hash_func,
+			 free_function key_free_func,
+			 free_function value_free_func);
 
 /**
  * table_is_empty() - Check if a table is empty.
  * @t: Table to check.
  *
- * Returns: True if table contains no key/key pairs, false otherwise.
+ * Returns: True if table contains no key/value pairs, false otherwise.
  */
 bool table_is_empty(const table *t);
 
 /**
- * table_insert() - Add a key/key pair to a table.
+ * table_insert() - Add a key/value pair to a table.
  * @t: Table to manipulate.
- * @key: A pointer to the key key.
- * @key: A pointer to the key key.
+ * @key: A pointer to the key.
+ * @value: A pointer to the value.
  *
- * Insert the key/key pair into the table. No test is performed to
+ * Insert the key/value pair into the table. No test is performed to
  * check if key is a duplicate. table_lookup() will return the latest
- * added key for a duplicate key. table_remove() will remove all
+ * added value for a duplicate key. table_remove() will remove all
  * duplicates for a given key.
  *
  * Returns: Nothing.
  */
-void table_insert(table *t, void *key, void *key);
+void table_insert(table *t, void *key, void *value);
 
 /**
  * table_lookup() - Look up a given key in a table.
  * @t: Table to inspect.
  * @key: Key to look up.
  *
- * Returns: The key corresponding to a given key, or NULL if the key
+ * Returns: The value corresponding to a given key, or NULL if the key
  * is not found in the table. If the table contains duplicate keys,
- * the key that was latest inserted will be returned.
+ * the value that was latest inserted will be returned.
  */
 void *table_lookup(const table *t, const void *key);
 
@@ -98,12 +165,12 @@ void *table_lookup(const table *t, const void *key);
 void *table_choose_key(const table *t);
 
 /**
- * table_remove() - Remove a key/key pair in the table.
+ * table_remove() - Remove a key/value pair in the table.
  * @t: Table to manipulate.
  * @key: Key for which to remove pair.
  *
  * Any matching duplicates will be removed. Will call any free
- * functions set for keys/keys. Does nothing if key is not found in
+ * functions set for keys/values. Does nothing if key is not found in
  * the table.
  *
  * Returns: Nothing.
@@ -115,9 +182,9 @@ void table_remove(table *t, const void *key);
  * @t: Table to destroy.
  *
  * Return all dynamic memory used by the table and its elements. If a
- * free_func was registered for keys and/or keys at table creation,
+ * free_func was registered for keys and/or values at table creation,
  * it is called each element to free any user-allocated memory
- * occupied by the element keys.
+ * occupied by the element keys and values.
  *
  * Returns: Nothing.
  */
@@ -126,13 +193,52 @@ void table_kill(table *t);
 /**
  * table_print() - Print the given table.
  * @t: Table to print.
- * @print_func: Function called for each key/key pair in the table.
+ * @print_func: Function called for each key/value pair in the table.
  *
- * Iterates over the key/key pairs in the table and prints them.
+ * Iterates over the key/value pairs in the table and prints them.
  * Will print all stored elements, including duplicates.
  *
  * Returns: Nothing.
  */
 void table_print(const table *t, inspect_callback_pair print_func);
 
+/**
+ * table_iter_begin() - Start iterating over the pairs of a table.
+ * @t: Table to inspect.
+ * @it: Iterator to set up.
+ *
+ * The iterator visits all stored pairs, including duplicates, in the
+ * order they are stored. Any insert or remove invalidates it.
+ *
+ * Returns: Nothing.
+ */
+void table_iter_begin(const table *t, table_iter *it);
+
+/**
+ * table_iter_next() - Advance an iterator to the next pair.
+ * @it: Iterator to advance.
+ * @key: Set to the key of the pair.
+ * @value: Set to the value of the pair.
+ *
+ * Returns: True if a pair was found, false when all pairs have been
+ * visited.
+ */
+bool table_iter_next(table_iter *it, void **key, void **value);
+
+/**
+ * table_drain() - Remove one pair from a table and hand it over.
+ * @t: Table to manipulate.
+ * @key: Set to the key of the removed pair.
+ * @value: Set to the value of the removed pair.
+ *
+ * Removes an arbitrary stored pair, duplicates one at a time. The
+ * free functions are not called: the caller takes over the key and
+ * value. Calling table_drain() until it returns false empties the
+ * table in time proportional to its size, unlike table_choose_key()
+ * followed by table_remove().
+ *
+ * Returns: True if a pair was removed, false if the table was empty.
+ */
+bool table_drain(table *t, void **key, void **value);
+
 #endif
@@ -13,6 +13,7 @@
  * Version information:
  *   2018-01-28: v1.0, first public version.
  *   2018-02-06: v1.1, updated explanation for the compare_function.
+ *   2026-10-17: v1.2, added hash_function.
  */
 
 // Type definition for de-allocator function, e.g. free().
@@ -27,12 +28,20 @@ typedef void (*inspect_callback_pair)(const void *, const void *);
 
 // Type definition for comparison function, used by e.g. table.
 //
-// Comparison functions should return keys that indicate the order
+// Comparison functions should return values that indicate the order
 // of the arguments. If the first argument is considered less/lower
-// than the second, a negative key should be returned. If the first
-// argument is considered more/higher than the second, a positive key
+// than the second, a negative value should be returned. If the first
+// argument is considered more/higher than the second, a positive value
 // should be returned. If the arguments are considered equal, a zero
-// key should be returned.
+// value should be returned.
 typedef int compare_function(const void *,const void *);
 
+// Type definition for hash function, used by e.g. the hashed table.
+//
+// Hash functions should return a value computed from the content of
+// the key. Keys that are considered equal by the compare_function
+// must give equal hash values. Unequal keys should give different
+// values as often as possible.
+typedef unsigned long hash_function(const void *);
+
 #endif
@@ -1,5 +1,7 @@
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "array_1d.h"
 
@@ -16,6 +18,12 @@
  *
  * Version information:
  *   2018-01-28: v1.0, first public version.
+ *   2026-10-17: v1.1, added array_1d_push(), array_1d_reserve() and
+ *		 array_1d_shrink_to_fit().
+ *   2026-10-17: v1.2, added array_1d_fill(), array_1d_clear_range(),
+ *		 array_1d_copy_range() and array_1d_slice_view().
+ *   2026-10-17: v1.3, added array_1d_create_indexed(),
+ *		 array_1d_next_key() and array_1d_count_keys().
  */
 
 // ===========INTERNAL DATA TYPES============
@@ -24,12 +32,135 @@ struct array_1d {
 	int low; // Low index limit.
 	int high; // High index limit.
 	int array_size; // Number of array elements.
+	int capacity; // Number of elements the storage has room for.
 	void **keys; // Pointer to where the actual keys are stored.
+	bool is_view; // True if the keys are owned by another array.
+	uint64_t *occupied; // Bitmap of positions with keys, or NULL.
+	int bit_base; // Bit in occupied of the first position.
 	free_function free_func; 
 };
 
 // ===========INTERNAL FUNCTION IMPLEMENTATIONS============
 
+// Number of bitmap words for n positions.
+#define BITMAP_WORDS(n) (((n) + 63) / 64)
+
+/*
+ * set_bit() - Mark the position at offset k as occupied or not. Does
+ * nothing if the array has no bitmap.
+ */
+static void set_bit(array_1d *a, int k, bool on)
+{
+	if (a->occupied != NULL) {
+		int b=a->bit_base + k;
+		uint64_t mask=1ULL << (b & 63);
+
+		if (on) {
+			a->occupied[b >> 6] |= mask;
+		} else {
+			a->occupied[b >> 6] &= ~mask;
+		}
+	}
+}
+
+/*
+ * set_bits() - Mark the positions at offsets lo..hi as occupied or
+ * not, a word at a time.
+ */
+static void set_bits(array_1d *a, int lo, int hi, bool on)
+{
+	int first=a->bit_base + lo;
+	int last=a->bit_base + hi;
+
+	for (int w=first >> 6; w<=last >> 6; w++) {
+		uint64_t mask=~0ULL;
+		if (w == first >> 6) {
+			mask &= ~0ULL << (first & 63);
+		}
+		if (w == last >> 6) {
+			mask &= ~0ULL >> (63 - (last & 63));
+		}
+		if (on) {
+			a->occupied[w] |= mask;
+		} else {
+			a->occupied[w] &= ~mask;
+		}
+	}
+}
+
+/*
+ * next_offset() - Find the first offset >= k with a key.
+ *
+ * Returns: The offset, or array_size if there is none.
+ */
+static int next_offset(const array_1d *a, int k)
+{
+	if (a->occupied == NULL) {
+		while (k < a->array_size && a->keys[k] == NULL) {
+			k++;
+		}
+		return k;
+	}
+	int end=a->bit_base + a->array_size;
+	int b=a->bit_base + k;
+
+	if (b >= end) {
+		return a->array_size;
+	}
+	int w=b >> 6;
+	uint64_t bits=a->occupied[w] & (~0ULL << (b & 63));
+	while (bits == 0) {
+		w++;
+		if (w * 64 >= end) {
+			return a->array_size;
+		}
+		bits=a->occupied[w];
+	}
+	b=w * 64 + __builtin_ctzll(bits);
+	return b < end ? b - a->bit_base : a->array_size;
+}
+
+/*
+ * set_capacity() - Reallocate the storage to room for n elements, n at
+ * least array_size. New elements are cleared.
+ *
+ * Returns: True, or false if the reallocation failed or a is a view.
+ * The storage is then unchanged.
+ */
+static bool set_capacity(array_1d *a, int n)
+{
+	// A view does not own its storage.
+	if (a->is_view) {
+		return false;
+	}
+	if (a->occupied != NULL) {
+		// Resize the bitmap first. A too large bitmap is harmless
+		// if the keys cannot be reallocated.
+		int old_words=BITMAP_WORDS(a->capacity);
+		int new_words=BITMAP_WORDS(n);
+		uint64_t *occupied=realloc(a->occupied,
+					   new_words * sizeof(uint64_t));
+		if (occupied == NULL) {
+			return false;
+		}
+		for (int w=old_words; w<new_words; w++) {
+			occupied[w]=0;
+		}
+		a->occupied=occupied;
+	}
+	void **keys=realloc(a->keys, n * sizeof(void *));
+
+	if (keys == NULL) {
+		return false;
+	}
+	for (int i=a->capacity; i<n; i++) {
+		keys[i]=NULL;
+	}
+	a->keys=keys;
+	a->capacity=n;
+	return true;
+}
+
 /**
  * array_1d_create() - Create an array without keys.
  * @lo: low index limit.
@@ -57,7 +188,10 @@ array_1d *array_1d_create(int lo, int hi, free_function free_func)
 	// Store free function.
 	a->free_func=free_func;
 	
-	a->keys=calloc(a->array_size, sizeof(void *));
+	// Allocate at least one element, so an array created empty to
+	// be pushed to still gets storage.
+	a->capacity = a->array_size > 0 ? a->array_size : 1;
+	a->keys=calloc(a->capacity, sizeof(void *));
 	
 	// Check whether the allocation succeeded.
 	if (a->keys == NULL) {
@@ -67,6 +201,36 @@ array_1d *array_1d_create(int lo, int hi, free_function free_func)
 	return a;
 }
 
+/**
+ * array_1d_create_indexed() - Create an array with an occupancy index.
+ * @lo: low index limit.
+ * @hi: high index limit.
+ * @free_func: A pointer to a function (or NULL) to be called to
+ *	       de-allocate memory on remove/kill.
+ *
+ * As array_1d_create(), but the array also keeps one bit per position
+ * that tells if a key is set. array_1d_next_key(), array_1d_count_keys()
+ * and array_1d_kill() then look at 64 positions at a time, which pays
+ * off for sparse arrays.
+ *
+ * Returns: A pointer to the new array, or NULL if not enough memory
+ * was available.
+ */
+array_1d *array_1d_create_indexed(int lo, int hi, free_function free_func)
+{
+	array_1d *a=array_1d_create(lo, hi, free_func);
+
+	if (a == NULL) {
+		return NULL;
+	}
+	a->occupied=calloc(BITMAP_WORDS(a->capacity), sizeof(uint64_t));
+	if (a->occupied == NULL) {
+		array_1d_kill(a);
+		return NULL;
+	}
+	return a;
+}
+
 /**
  * array_1d_low() - Return the low index limit for the array.
  * @a: array to inspect.
@@ -118,6 +282,59 @@ bool array_1d_has_key(const array_1d *a, int i)
 	return a->keys[offset] != NULL;
 }
 
+/**
+ * array_1d_next_key() - Find the next position with a key.
+ * @a: array to inspect.
+ * @i: index to start at, low <= i <= high + 1.
+ *
+ * Can be used to visit the keys in index order:
+ *
+ *   for (i=array_1d_next_key(a, array_1d_low(a)); i<=array_1d_high(a);
+ *	  i=array_1d_next_key(a, i+1))
+ *
+ * Returns: The smallest index k >= i with a key set, or high + 1 if
+ * there is none.
+ */
+int array_1d_next_key(const array_1d *a, int i)
+{
+	return next_offset(a, i-array_1d_low(a)) + array_1d_low(a);
+}
+
+/**
+ * array_1d_count_keys() - Count the positions with a key.
+ * @a: array to inspect.
+ *
+ * Returns: The number of positions with a key set.
+ */
+int array_1d_count_keys(const array_1d *a)
+{
+	if (a->occupied == NULL) {
+		int count=0;
+		for (int k=0; k<a->array_size; k++) {
+			count += a->keys[k] != NULL;
+		}
+		return count;
+	}
+	if (a->array_size <= 0) {
+		return 0;
+	}
+	// Count the set bits in the words covering the positions.
+	int first=a->bit_base;
+	int last=a->bit_base + a->array_size - 1;
+	int count=0;
+	for (int w=first >> 6; w<=last >> 6; w++) {
+		uint64_t bits=a->occupied[w];
+		if (w == first >> 6) {
+			bits &= ~0ULL << (first & 63);
+		}
+		if (w == last >> 6) {
+			bits &= ~0ULL >> (63 - (last & 63));
+		}
+		count += __builtin_popcountll(bits);
+	}
+	return count;
+}
+
 /**
  * array_1d_set_key() - Set a key at a given array position.
  * @a: array to modify.
@@ -138,6 +355,205 @@ void array_1d_set_key(array_1d *a, void *v, int i)
 	}
 	// Set key.
 	a->keys[offset]=v;
+	set_bit(a, offset, v != NULL);
+}
+
+/**
+ * array_1d_push() - Add a key after the last array position.
+ * @a: array to modify.
+ * @v: key to store at the new position, or NULL.
+ *
+ * Increases the high index limit by one and sets the key at the new
+ * high index. The low index limit is not changed.
+ *
+ * Returns: True, or false if not enough memory was available. The
+ * array is then unchanged.
+ */
+bool array_1d_push(array_1d *a, void *v)
+{
+	// Double the storage when full.
+	if (a->array_size == a->capacity
+	    && !set_capacity(a, 2 * a->capacity)) {
+		return false;
+	}
+	a->keys[a->array_size]=v;
+	set_bit(a, a->array_size, v != NULL);
+	a->array_size++;
+	a->high++;
+	return true;
+}
+
+/**
+ * array_1d_reserve() - Make room for a number of elements.
+ * @a: array to modify.
+ * @n: number of elements to make room for.
+ *
+ * Allocates storage for at least n elements, so the array can be
+ * pushed to n elements without reallocating. The index limits are not
+ * changed.
+ *
+ * Returns: True, or false if not enough memory was available. The
+ * array is then unchanged.
+ */
+bool array_1d_reserve(array_1d *a, int n)
+{
+	if (n <= a->capacity) {
+		return true;
+	}
+	return set_capacity(a, n);
+}
+
+/**
+ * array_1d_shrink_to_fit() - Return unused storage.
+ * @a: array to modify.
+ *
+ * Shrinks the storage to the elements between the index limits.
+ *
+ * Returns: Nothing.
+ */
+void array_1d_shrink_to_fit(array_1d *a)
+{
+	int n = a->array_size > 0 ? a->array_size : 1;
+
+	if (n < a->capacity) {
+		// Keep the old storage if the reallocation fails.
+		set_capacity(a, n);
+	}
+}
+
+/**
+ * array_1d_fill() - Set the same key at a range of array positions.
+ * @a: array to modify.
+ * @v: key to set, or NULL.
+ * @i: first index of the range.
+ * @j: last index of the range.
+ *
+ * Sets the key v at all positions i <= k <= j. Any old keys in the
+ * range are de-allocated by the free_func, if specified. Since the
+ * same key is stored at every position, a non-NULL v should only be
+ * used if the array has no free_func or the range has one element.
+ *
+ * Returns: Nothing.
+ */
+void array_1d_fill(array_1d *a, void *v, int i, int j)
+{
+	int lo=i-array_1d_low(a);
+	int hi=j-array_1d_low(a);
+
+	if (hi < lo) {
+		return;
+	}
+	if (a->free_func != NULL) {
+		// Return the old keys in the range.
+		for (int k=next_offset(a, lo); k<=hi; k=next_offset(a, k+1)) {
+			a->free_func(a->keys[k]);
+		}
+	}
+	if (v == NULL) {
+		memset(a->keys + lo, 0, (hi-lo+1) * sizeof(void *));
+	} else {
+		for (int k=lo; k<=hi; k++) {
+			a->keys[k]=v;
+		}
+	}
+	if (a->occupied != NULL) {
+		set_bits(a, lo, hi, v != NULL);
+	}
+}
+
+/**
+ * array_1d_clear_range() - Remove the keys from a range of positions.
+ * @a: array to modify.
+ * @i: first index of the range.
+ * @j: last index of the range.
+ *
+ * Sets all positions i <= k <= j to "no" key. Any old keys in the
+ * range are de-allocated by the free_func, if specified.
+ *
+ * Returns: Nothing.
+ */
+void array_1d_clear_range(array_1d *a, int i, int j)
+{
+	array_1d_fill(a, NULL, i, j);
+}
+
+/**
+ * array_1d_copy_range() - Copy keys from one array to another.
+ * @dst: array to copy to.
+ * @d: index in dst of the first copied key.
+ * @src: array to copy from.
+ * @i: index in src of the first key to copy.
+ * @j: index in src of the last key to copy.
+ *
+ * Sets the keys at src positions i..j at dst positions d..d+j-i. The
+ * key pointers are copied, not the keys themselves. Any old keys in
+ * the dst range are de-allocated by the free_func of dst, if
+ * specified. The arrays may be the same, with overlapping ranges,
+ * unless dst has a free_func.
+ *
+ * Returns: Nothing.
+ */
+void array_1d_copy_range(array_1d *dst, int d, const array_1d *src,
+			 int i, int j)
+{
+	int n=j-i+1;
+	int from=i-array_1d_low(src);
+	int to=d-array_1d_low(dst);
+
+	if (n <= 0) {
+		return;
+	}
+	if (dst->free_func != NULL) {
+		// Return the keys that are overwritten.
+		for (int k=next_offset(dst, to); k<to+n;
+		     k=next_offset(dst, k+1)) {
+			dst->free_func(dst->keys[k]);
+		}
+	}
+	// The ranges may overlap if the arrays are the same.
+	memmove(dst->keys + to, src->keys + from, n * sizeof(void *));
+	if (dst->occupied != NULL) {
+		for (int k=to; k<to+n; k++) {
+			set_bit(dst, k, dst->keys[k] != NULL);
+		}
+	}
+}
+
+/**
+ * array_1d_slice_view() - Create a view of a range of an array.
+ * @a: array to view.
+ * @i: low index limit of the view.
+ * @j: high index limit of the view.
+ *
+ * The view shares its storage with a, so no keys are copied, and
+ * uses the same indices as a. Keys set in the view are set in a. The
+ * view has no free_func and cannot grow. It must be killed with
+ * array_1d_kill() before a is killed, and becomes invalid if the
+ * storage of a is reallocated by array_1d_push(), array_1d_reserve()
+ * or array_1d_shrink_to_fit().
+ *
+ * Returns: A pointer to the view, or NULL if not enough memory was
+ * available.
+ */
+array_1d *array_1d_slice_view(const array_1d *a, int i, int j)
+{
+	array_1d *v=calloc(1, sizeof(*v));
+
+	if (v == NULL) {
+		return NULL;
+	}
+	v->low=i;
+	v->high=j;
+	v->array_size=j-i+1;
+	// A full view cannot grow.
+	v->capacity=v->array_size;
+	v->keys=a->keys + (i-array_1d_low(a));
+	v->free_func=NULL;
+	v->is_view=true;
+	// Share the bitmap, if any.
+	v->occupied=a->occupied;
+	v->bit_base=a->bit_base + (i-array_1d_low(a));
+	return v;
 }
 
 /**
@@ -145,22 +561,28 @@ void array_1d_set_key(array_1d *a, void *v, int i)
  * @a: array to kill.
  * 
  * Iterates over all elements. If free_func was specified at array
- * creation, calls it for every non-NULL element key.
+ * creation, calls it for every non-NULL element key. Killing a view
+ * only returns the view itself.
  *
  * Returns: Nothing.
  */
 void array_1d_kill(array_1d *a)
 {
+	if (a->is_view) {
+		// Only free the view structure.
+		free(a);
+		return;
+	}
 	if (a->free_func) {
 		// Return user-allocated memory for each non-NULL element.
-		for (int i=0; i<a->array_size; i++) {
-			if (a->keys[i] != NULL) {
-				a->free_func(a->keys[i]);
-			}
+		for (int i=next_offset(a, 0); i<a->array_size;
+		     i=next_offset(a, i+1)) {
+			a->free_func(a->keys[i]);
 		}
 	}
 	// Free actual storage.
 	free(a->keys);
+	free(a->occupied);
 	// Free array structure.
 	free(a);
 }
@@ -0,0 +1,59 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "array_1d.h"
+
+/*
+ * Minimum working example 5 for array_1d.c. Creates an empty array and
+ * pushes n keys to it, with n given as argument (default 10). Shows how
+ * to make room in advance and how to return unused storage.
+ *
+ * Version information:
+ *   2026-10-17: v1.0, first public version.
+ */
+
+// Integers are stored via int pointers stored as void pointers.
+// Convert the given pointer and print the dereferenced key.
+static void print_ints(const void *data)
+{
+	printf("%d", *(int*)data);
+}
+
+int main(int argc, char *argv[])
+{
+	int n = argc > 1 ? atoi(argv[1]) : 10;
+
+	// Create an empty array with low index 1. The array handles
+	// the deallocation of the keys.
+	array_1d *a = array_1d_create(1, 0, free);
+
+	// Push the first half. The array grows as needed.
+	for (int i=1; i<=n/2; i++) {
+		int *v=malloc(sizeof(*v));
+		*v=i;
+		array_1d_push(a, v);
+	}
+	// Make room for the rest in advance, then push it.
+	array_1d_reserve(a, n);
+	for (int i=n/2+1; i<=n; i++) {
+		int *v=malloc(sizeof(*v));
+		*v=i;
+		array_1d_push(a, v);
+	}
+	printf("Index limits: [%d, %d]\n", array_1d_low(a), array_1d_high(a));
+	if (n <= 20) {
+		array_1d_print(a, print_ints);
+	}
+
+	// Return unused storage. The keys are not changed.
+	array_1d_shrink_to_fit(a);
+	long sum = 0;
+	for (int i=array_1d_low(a); i<=array_1d_high(a); i++) {
+		sum += *(int *)array_1d_inspect_key(a, i);
+	}
+	printf("Sum of keys: %ld\n", sum);
+
+	// Kill the array, keys included.
+	array_1d_kill(a);
+
+	return 0;
+}
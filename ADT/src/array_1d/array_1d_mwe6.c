@@ -0,0 +1,59 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "array_1d.h"
+
+/*
+ * Minimum working example 6 for array_1d.c. Fills, copies and clears
+ * ranges of an array of static keys, and sums a range through a view
+ * that shares the storage of the array.
+ *
+ * Version information:
+ *   2026-10-17: v1.0, first public version.
+ */
+
+// Integers are stored via int pointers stored as void pointers.
+// Convert the given pointer and print the dereferenced key.
+static void print_ints(const void *data)
+{
+	printf("%d", *(int*)data);
+}
+
+int main(void)
+{
+	static int values[] = { 1, 2, 3, 4, 5 };
+
+	// The keys are static, so no free function is given.
+	array_1d *a = array_1d_create(1, 10, NULL);
+
+	// Set the same key at positions 1-4.
+	array_1d_fill(a, &values[0], 1, 4);
+	for (int i=0; i<5; i++) {
+		array_1d_set_key(a, &values[i], 6+i);
+	}
+	array_1d_print(a, print_ints);
+
+	// Copy positions 6-10 to 3-7. The ranges overlap.
+	array_1d_copy_range(a, 3, a, 6, 10);
+	array_1d_print(a, print_ints);
+
+	// Sum positions 4-8 through a view. The view uses the same
+	// indices as the array.
+	array_1d *v = array_1d_slice_view(a, 4, 8);
+	int sum = 0;
+	for (int i=array_1d_low(v); i<=array_1d_high(v); i++) {
+		if (array_1d_has_key(v, i)) {
+			sum += *(int *)array_1d_inspect_key(v, i);
+		}
+	}
+	printf("Sum of positions %d-%d: %d\n", array_1d_low(v),
+	       array_1d_high(v), sum);
+
+	// Clear through the view. The keys are removed from the array.
+	array_1d_clear_range(v, 5, 6);
+	array_1d_kill(v);
+	array_1d_print(a, print_ints);
+
+	array_1d_kill(a);
+
+	return 0;
+}
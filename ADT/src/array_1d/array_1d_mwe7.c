@@ -0,0 +1,47 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "array_1d.h"
+
+/*
+ * Minimum working example 7 for array_1d.c. Creates a sparse array of
+ * n positions, with n given as argument (default 1000000), where every
+ * 50th position has a key. Counts and sums the keys using the
+ * occupancy index, then clears a range and counts again.
+ *
+ * Version information:
+ *   2026-10-17: v1.0, first public version.
+ */
+
+int main(int argc, char *argv[])
+{
+	int n = argc > 1 ? atoi(argv[1]) : 1000000;
+
+	// Create an indexed array. The array handles the deallocation
+	// of the keys.
+	array_1d *a = array_1d_create_indexed(1, n, free);
+
+	for (int i=1; i<=n; i+=50) {
+		int *v=malloc(sizeof(*v));
+		*v=i;
+		array_1d_set_key(a, v, i);
+	}
+	printf("Keys set: %d\n", array_1d_count_keys(a));
+
+	// Visit the keys only, skipping the empty positions.
+	long sum = 0;
+	for (int i=array_1d_next_key(a, array_1d_low(a)); i<=array_1d_high(a);
+	     i=array_1d_next_key(a, i+1)) {
+		sum += *(int *)array_1d_inspect_key(a, i);
+	}
+	printf("Sum of keys: %ld\n", sum);
+
+	// Clear the first half. The removed keys are deallocated.
+	array_1d_clear_range(a, 1, n/2);
+	printf("Keys set after clearing [1, %d]: %d\n", n/2,
+	       array_1d_count_keys(a));
+
+	// Kill the array, keys included.
+	array_1d_kill(a);
+
+	return 0;
+}
@@ -15,6 +15,8 @@
  * Version information:
  *   2018-01-28: v1.0, first public version.
  *   2018-04-03: v1.1, moved freehandler last in create parameter list.
+ *   2026-10-17: v1.2, added array_2d_create_tiled() and block
+ *		 iteration.
  */
 
 // ===========INTERNAL DATA TYPES============
@@ -23,12 +25,16 @@ struct array_2d {
 	int low[2]; // Low index limits.
 	int high[2]; // High index limits.
 	int array_size; // Number of array elements.
+	int tile_rows; // Tiles along the first dimension, 0 if not tiled.
 	void **keys; // Pointer to where the actual keys are stored.
 	free_function free_func; 
 };
 
 // ===========INTERNAL FUNCTION IMPLEMENTATIONS============
 
+// Log2 of ARRAY_2D_TILE.
+#define TILE_SHIFT 3
+
 /**
  * array_2d_create() - Create an array without keys.
  * @lo1: low index limit for first dimension.
@@ -71,6 +77,51 @@ array_2d *array_2d_create(int lo1, int hi1, int lo2, int hi2,
 	return a;
 }
 
+/**
+ * array_2d_create_tiled() - Create an array with tiled storage.
+ * @lo1: low index limit for first dimension.
+ * @hi1: high index limit for first dimension.
+ * @lo2: low index limit for second dimension.
+ * @hi2: high index limit for second dimension.
+ * @free_func: A pointer to a function (or NULL) to be called to
+ *	       de-allocate memory on remove/kill.
+ *
+ * As array_2d_create(), but the keys are stored in tiles of
+ * ARRAY_2D_TILE x ARRAY_2D_TILE positions. The keys of a tile are
+ * stored together, so a traversal along either dimension touches
+ * few cache lines, especially when done block by block.
+ *
+ * Returns: A pointer to the new array, or NULL if not enough memory
+ * was available.
+ */
+array_2d *array_2d_create_tiled(int lo1, int hi1, int lo2, int hi2,
+				free_function free_func)
+{
+	array_2d *a=calloc(1, sizeof(*a));
+	if (a == NULL) {
+		return NULL;
+	}
+	a->low[0]=lo1;
+	a->low[1]=lo2;
+	a->high[0]=hi1;
+	a->high[1]=hi2;
+
+	// Round both dimensions up to whole tiles.
+	int tiles1=(hi1-lo1+ARRAY_2D_TILE)/ARRAY_2D_TILE;
+	int tiles2=(hi2-lo2+ARRAY_2D_TILE)/ARRAY_2D_TILE;
+	a->tile_rows=tiles1;
+	a->array_size=tiles1*tiles2*ARRAY_2D_TILE*ARRAY_2D_TILE;
+
+	a->free_func=free_func;
+
+	a->keys=calloc(a->array_size, sizeof(void *));
+	if (a->keys == NULL) {
+		free(a);
+		a=NULL;
+	}
+	return a;
+}
+
 /**
  * array_2d_low() - Return the low index limit for the array.
  * @a: array to inspect.
@@ -108,6 +159,16 @@ int array_2d_high(const array_2d *a, int d)
  */
 static int array_2d_linear_index(const array_2d *a,int i, int j)
 {
+	if (a->tile_rows > 0) {
+		// Tiles and the positions within a tile are both stored
+		// with the first index varying fastest.
+		// The offsets are non-negative, so shift and mask.
+		unsigned r=i-a->low[0];
+		unsigned c=j-a->low[1];
+		unsigned tile=(r>>TILE_SHIFT) + (c>>TILE_SHIFT)*a->tile_rows;
+		return (tile<<2*TILE_SHIFT) + (r&(ARRAY_2D_TILE-1))
+			+ ((c&(ARRAY_2D_TILE-1))<<TILE_SHIFT);
+	}
 	int rows=a->high[0]-a->low[0]+1;
 	int ix=(i-a->low[0])+(j-a->low[1])*rows;
 	//fprintf(stderr,"(%d,%d) -> %d\n",i,j,ix);
@@ -168,6 +229,67 @@ void array_2d_set_key(array_2d *a, void *v, int i, int j)
 	a->keys[ix]=v;
 }
 
+/**
+ * array_2d_block_begin() - Start a traversal of the array in blocks.
+ * @a: array to traverse.
+ * @b: block to initialize.
+ *
+ * The blocks cover the array in ARRAY_2D_TILE x ARRAY_2D_TILE
+ * positions, cut at the index limits. They match the tiles of a
+ * tiled array. Each block is set by array_2d_block_next().
+ *
+ * Returns: Nothing.
+ */
+void array_2d_block_begin(const array_2d *a, array_2d_block *b)
+{
+	// An empty block before the first one.
+	b->low[0]=a->low[0]-ARRAY_2D_TILE;
+	b->low[1]=a->low[1];
+	b->high[0]=b->low[0]-1;
+	b->high[1]=b->low[1]-1;
+}
+
+/**
+ * array_2d_block_next() - Move to the next block of the array.
+ * @a: array to traverse.
+ * @b: block from array_2d_block_begin() or the previous call.
+ *
+ * Sets the index limits of b to the next block. The blocks are
+ * visited in storage order, first along the first dimension. Within
+ * a block, the first index should vary fastest:
+ *
+ *   array_2d_block_begin(a, &b);
+ *   while (array_2d_block_next(a, &b))
+ *	   for (j=b.low[1]; j<=b.high[1]; j++)
+ *		   for (i=b.low[0]; i<=b.high[0]; i++)
+ *
+ * Returns: True, or false if all blocks have been visited.
+ */
+bool array_2d_block_next(const array_2d *a, array_2d_block *b)
+{
+	if (a->high[0] < a->low[0]) {
+		return false;
+	}
+	b->low[0]+=ARRAY_2D_TILE;
+	if (b->low[0] > a->high[0]) {
+		// Start the next column of blocks.
+		b->low[0]=a->low[0];
+		b->low[1]+=ARRAY_2D_TILE;
+	}
+	if (b->low[1] > a->high[1]) {
+		return false;
+	}
+	b->high[0]=b->low[0]+ARRAY_2D_TILE-1;
+	if (b->high[0] > a->high[0]) {
+		b->high[0]=a->high[0];
+	}
+	b->high[1]=b->low[1]+ARRAY_2D_TILE-1;
+	if (b->high[1] > a->high[1]) {
+		b->high[1]=a->high[1];
+	}
+	return true;
+}
+
 /**
  * array_2d_kill() - Return memory allocated by array.
  * @a: array to kill.
@@ -0,0 +1,64 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include "array_2d.h"
+
+/*
+ * Minimum working example 3 for array_2d.c. Creates a tiled n-by-n
+ * array, with n given as argument (default 20), and sets the key at
+ * (i,j) to i*j. Then visits the array block by block and transposes
+ * it into a second tiled array. Both traversals stay within one tile
+ * at a time.
+ *
+ * Version information:
+ *   2026-10-17: v1.0, first public version.
+ */
+
+int main(int argc, char *argv[])
+{
+	int n = argc > 1 ? atoi(argv[1]) : 20;
+
+	// The arrays handle the deallocation of the keys.
+	array_2d *a = array_2d_create_tiled(1, n, 1, n, free);
+	array_2d *t = array_2d_create_tiled(1, n, 1, n, free);
+
+	array_2d_block b;
+	int blocks = 0;
+	long sum = 0;
+	array_2d_block_begin(a, &b);
+	while (array_2d_block_next(a, &b)) {
+		// Let the first index vary fastest.
+		for (int j=b.low[1]; j<=b.high[1]; j++) {
+			for (int i=b.low[0]; i<=b.high[0]; i++) {
+				int *v=malloc(sizeof(*v));
+				*v=i*j;
+				array_2d_set_key(a, v, i, j);
+				sum += *v;
+			}
+		}
+		blocks++;
+	}
+	printf("Set %d keys in %d blocks, sum %ld\n", n*n, blocks, sum);
+
+	// Transpose block by block.
+	array_2d_block_begin(a, &b);
+	while (array_2d_block_next(a, &b)) {
+		for (int j=b.low[1]; j<=b.high[1]; j++) {
+			for (int i=b.low[0]; i<=b.high[0]; i++) {
+				int *v=malloc(sizeof(*v));
+				*v=*(int *)array_2d_inspect_key(a, i, j);
+				array_2d_set_key(t, v, j, i);
+			}
+		}
+	}
+	int i = n/2;
+	int j = n/3 + 1;
+	printf("a(%d,%d) = %d, t(%d,%d) = %d\n", i, j,
+	       *(int *)array_2d_inspect_key(a, i, j), j, i,
+	       *(int *)array_2d_inspect_key(t, j, i));
+
+	// Kill the arrays, keys included.
+	array_2d_kill(a);
+	array_2d_kill(t);
+
+	return 0;
+}
@@ -0,0 +1,394 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "double_array_2d.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+/*
+ * Implementation of a floating-point 2D array for the "Datastructures and
+ * algorithms" courses at the Department of Computing Science, Umea
+ * University.
+ *
+ * Version information:
+ *   2026-10-17: v1.0, first public version.
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+// Alignment of each column, in bytes.
+#define ALIGNMENT 32
+
+struct double_array_2d {
+	int low[2]; // Low index limits.
+	int high[2]; // High index limits.
+	int rows; // Number of positions along the first dimension.
+	int cols; // Number of positions along the second dimension.
+	int stride; // Distance between columns, rows rounded up to ALIGNMENT.
+	double *keys; // Aligned pointer to where the actual keys are stored.
+	void *block; // Allocated memory holding the keys.
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+/*
+ * column() - Return a pointer to the first key of column c, counted
+ * from 0. The pointer is aligned to ALIGNMENT bytes.
+ */
+static double *column(const double_array_2d *a, int c)
+{
+	return a->keys + (size_t)c * a->stride;
+}
+
+#ifdef __AVX2__
+/*
+ * sum_lanes() - Return the sum of the four lanes of x.
+ */
+static double sum_lanes(__m256d x)
+{
+	__m128d s=_mm_add_pd(_mm256_castpd256_pd128(x),
+			     _mm256_extractf128_pd(x, 1));
+	return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+}
+#endif
+
+/*
+ * min_max() - Find the smallest and largest key in one pass.
+ */
+static void min_max(const double_array_2d *a, double *min, double *max)
+{
+	if (a->rows == 0 || a->cols == 0) {
+		*min=0;
+		*max=0;
+		return;
+	}
+	double lo=a->keys[0];
+	double hi=a->keys[0];
+#ifdef __AVX2__
+	__m256d vlo=_mm256_set1_pd(lo);
+	__m256d vhi=vlo;
+#endif
+	for (int c=0; c<a->cols; c++) {
+		const double *k=column(a, c);
+		int i=0;
+#ifdef __AVX2__
+		for (; i+4<=a->rows; i+=4) {
+			__m256d x=_mm256_load_pd(k+i);
+			vlo=_mm256_min_pd(vlo, x);
+			vhi=_mm256_max_pd(vhi, x);
+		}
+#endif
+		for (; i<a->rows; i++) {
+			lo = k[i] < lo ? k[i] : lo;
+			hi = k[i] > hi ? k[i] : hi;
+		}
+	}
+#ifdef __AVX2__
+	double l[4];
+	double h[4];
+	_mm256_storeu_pd(l, vlo);
+	_mm256_storeu_pd(h, vhi);
+	for (int i=0; i<4; i++) {
+		lo = l[i] < lo ? l[i] : lo;
+		hi = h[i] > hi ? h[i] : hi;
+	}
+#endif
+	*min=lo;
+	*max=hi;
+}
+
+/**
+ * double_array_2d_create() - Create an array without keys.
+ * @lo1: low index limit for first dimension.
+ * @hi1: high index limit for first dimension.
+ * @lo2: low index limit for second dimension.
+ * @hi2: high index limit for second dimension.
+ *
+ * The index limits are inclusive, i.e. all indices i such that low <=
+ * i <= high are defined.
+ *
+ * Returns: A pointer to the new array, or NULL if not enough memory
+ * was available.
+ */
+double_array_2d *double_array_2d_create(int lo1, int hi1, int lo2, int hi2)
+{
+	// Allocate array structure.
+	double_array_2d *a=calloc(1, sizeof(*a));
+	if (a == NULL) {
+		return NULL;
+	}
+	// Store index limits.
+	a->low[0]=lo1;
+	a->low[1]=lo2;
+	a->high[0]=hi1;
+	a->high[1]=hi2;
+
+	a->rows=hi1-lo1+1;
+	a->cols=hi2-lo2+1;
+	// Round the columns up to whole vectors, so each one is aligned.
+	int per_vector=ALIGNMENT/sizeof(double);
+	a->stride=(a->rows+per_vector-1)/per_vector*per_vector;
+
+	size_t size=(size_t)a->stride * a->cols * sizeof(double);
+	a->block=calloc(size+ALIGNMENT, 1);
+
+	// Check whether the allocation succeeded.
+	if (a->block == NULL) {
+		free(a);
+		return NULL;
+	}
+	a->keys=(double *)(((uintptr_t)a->block + ALIGNMENT-1)
+			& ~(uintptr_t)(ALIGNMENT-1));
+	return a;
+}
+
+/**
+ * double_array_2d_low() - Return the low index limit for the array.
+ * @a: array to inspect.
+ * @d: dimension number, 1 or 2.
+ *
+ * Returns: The low index limit for dimension number d.
+ */
+int double_array_2d_low(const double_array_2d *a, int d)
+{
+	return a->low[d-1];
+}
+
+/**
+ * double_array_2d_high() - Return the high index limit for the array.
+ * @a: array to inspect.
+ * @d: dimension number, 1 or 2.
+ *
+ * Returns: The high index limit for dimension number d.
+ */
+int double_array_2d_high(const double_array_2d *a, int d)
+{
+	return a->high[d-1];
+}
+
+/**
+ * double_array_2d_inspect_key() - Inspect a key at a given array position.
+ * @a: array to inspect.
+ * @i: first index of position to inspect.
+ * @j: second index of position to inspect.
+ *
+ * Returns: The element key at the specified position, or 0 if no
+ *	    key is stored at that position.
+ */
+double double_array_2d_inspect_key(const double_array_2d *a, int i, int j)
+{
+	return column(a, j-a->low[1])[i-a->low[0]];
+}
+
+/**
+ * double_array_2d_has_key() - Check if a key is set at a given array position.
+ * @a: array to inspect.
+ * @i: first index of position to inspect.
+ * @j: second index of position to inspect.
+ *
+ * Returns: True if a key is set at the specified position, otherwise false.
+ */
+bool double_array_2d_has_key(const double_array_2d *a, int i, int j)
+{
+	return double_array_2d_inspect_key(a, i, j) != 0;
+}
+
+/**
+ * double_array_2d_set_key() - Set a key at a given array position.
+ * @a: array to modify.
+ * @v: key to set element to, or 0 to clear key.
+ * @i: first index of position to modify.
+ * @j: second index of position to modify.
+ *
+ * Returns: Nothing.
+ */
+void double_array_2d_set_key(double_array_2d *a, double v, int i, int j)
+{
+	column(a, j-a->low[1])[i-a->low[0]]=v;
+}
+
+/**
+ * double_array_2d_fill() - Set all positions to the same key.
+ * @a: array to modify.
+ * @v: key to set, or 0 to clear all keys.
+ *
+ * Returns: Nothing.
+ */
+void double_array_2d_fill(double_array_2d *a, double v)
+{
+#ifdef __AVX2__
+	__m256d x=_mm256_set1_pd(v);
+#endif
+	for (int c=0; c<a->cols; c++) {
+		double *k=column(a, c);
+		int i=0;
+#ifdef __AVX2__
+		for (; i+4<=a->rows; i+=4) {
+			_mm256_store_pd(k+i, x);
+		}
+#endif
+		for (; i<a->rows; i++) {
+			k[i]=v;
+		}
+	}
+}
+
+/**
+ * double_array_2d_add() - Add an array to another, element by element.
+ * @a: array to modify.
+ * @b: array to add. Must have the same index limits as a.
+ *
+ * Returns: Nothing.
+ */
+void double_array_2d_add(double_array_2d *a, const double_array_2d *b)
+{
+	for (int c=0; c<a->cols; c++) {
+		double *k=column(a, c);
+		const double *l=column(b, c);
+		int i=0;
+#ifdef __AVX2__
+		for (; i+4<=a->rows; i+=4) {
+			_mm256_store_pd(k+i, _mm256_add_pd(_mm256_load_pd(k+i),
+							   _mm256_load_pd(l+i)));
+		}
+#endif
+		for (; i<a->rows; i++) {
+			k[i]+=l[i];
+		}
+	}
+}
+
+/**
+ * double_array_2d_min() - Return the smallest key in the array.
+ * @a: array to inspect.
+ *
+ * Returns: The smallest key, or 0 if the array has no positions.
+ */
+double double_array_2d_min(const double_array_2d *a)
+{
+	double min;
+	double max;
+	min_max(a, &min, &max);
+	return min;
+}
+
+/**
+ * double_array_2d_max() - Return the largest key in the array.
+ * @a: array to inspect.
+ *
+ * Returns: The largest key, or 0 if the array has no positions.
+ */
+double double_array_2d_max(const double_array_2d *a)
+{
+	double min;
+	double max;
+	min_max(a, &min, &max);
+	return max;
+}
+
+/**
+ * double_array_2d_row_sums() - Sum the keys along the second dimension.
+ * @a: array to inspect.
+ * @sums: room for one sum per first index.
+ *
+ * Sets sums[i-lo1] to the sum of the keys at (i,j) over all j.
+ *
+ * Returns: Nothing.
+ */
+void double_array_2d_row_sums(const double_array_2d *a, double *sums)
+{
+	for (int i=0; i<a->rows; i++) {
+		sums[i]=0;
+	}
+	// Add one column at a time to all sums.
+	for (int c=0; c<a->cols; c++) {
+		const double *k=column(a, c);
+		int i=0;
+#ifdef __AVX2__
+		for (; i+4<=a->rows; i+=4) {
+			_mm256_storeu_pd(sums+i, _mm256_add_pd(
+				_mm256_loadu_pd(sums+i), _mm256_load_pd(k+i)));
+		}
+#endif
+		for (; i<a->rows; i++) {
+			sums[i]+=k[i];
+		}
+	}
+}
+
+/**
+ * double_array_2d_col_sums() - Sum the keys along the first dimension.
+ * @a: array to inspect.
+ * @sums: room for one sum per second index.
+ *
+ * Sets sums[j-lo2] to the sum of the keys at (i,j) over all i.
+ *
+ * Returns: Nothing.
+ */
+void double_array_2d_col_sums(const double_array_2d *a, double *sums)
+{
+	for (int c=0; c<a->cols; c++) {
+		const double *k=column(a, c);
+		double s=0;
+		int i=0;
+#ifdef __AVX2__
+		// Two accumulators, to hide the latency of the adds.
+		__m256d s0=_mm256_setzero_pd();
+		__m256d s1=_mm256_setzero_pd();
+		for (; i+8<=a->rows; i+=8) {
+			s0=_mm256_add_pd(s0, _mm256_load_pd(k+i));
+			s1=_mm256_add_pd(s1, _mm256_load_pd(k+i+4));
+		}
+		s=sum_lanes(_mm256_add_pd(s0, s1));
+#endif
+		for (; i<a->rows; i++) {
+			s+=k[i];
+		}
+		sums[c]=s;
+	}
+}
+
+/**
+ * double_array_2d_kill() - Return memory allocated by array.
+ * @a: array to kill.
+ *
+ * Returns: Nothing.
+ */
+void double_array_2d_kill(double_array_2d *a)
+{
+	// Free actual storage.
+	free(a->block);
+	// Free array structure.
+	free(a);
+}
+
+/**
+ * double_array_2d_print() - Iterate over the array element and print their keys.
+ * @a: Array to inspect.
+ *
+ * Iterates over each position in the array. Prints each non-zero element.
+ *
+ * Returns: Nothing.
+ */
+void double_array_2d_print(const double_array_2d *a)
+{
+	printf("[\n");
+	for (int i=double_array_2d_low(a,1); i<=double_array_2d_high(a,1); i++) {
+		printf(" [ ");
+		for (int j=double_array_2d_low(a,2); j<=double_array_2d_high(a,2); j++) {
+			if (double_array_2d_has_key(a,i,j)) {
+				printf("[%g]",double_array_2d_inspect_key(a,i,j));
+			} else {
+				printf("[  ]");
+			}
+			if (j<double_array_2d_high(a,2)) {
+				printf(", ");
+			}
+		}
+		printf(" ]\n");
+	}
+	printf(" ]\n");
+}
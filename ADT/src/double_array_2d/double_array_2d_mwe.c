@@ -0,0 +1,48 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "double_array_2d.h"
+
+/*
+ * Minimum working example for double_array_2d.c. Creates a 4-by-3 array
+ * with the key i/j at (i,j), adds a filled array to it, and prints the
+ * sums along each dimension and the smallest and largest key.
+ *
+ * Version information:
+ *   2026-10-17: v1.0, first public version.
+ */
+
+int main(void)
+{
+	// Create two 4-by-3 arrays.
+	double_array_2d *a = double_array_2d_create(1,4,1,3);
+	double_array_2d *b = double_array_2d_create(1,4,1,3);
+
+	for (int i=double_array_2d_low(a,1); i<=double_array_2d_high(a,1); i++) {
+		for (int j=double_array_2d_low(a,2); j<=double_array_2d_high(a,2); j++) {
+			double_array_2d_set_key(a,(double)i/j,i,j);
+		}
+	}
+	double_array_2d_print(a);
+
+	// Add 0.5 to every key.
+	double_array_2d_fill(b,0.5);
+	double_array_2d_add(a,b);
+	double_array_2d_print(a);
+
+	double rows[4];
+	double cols[3];
+	double_array_2d_row_sums(a,rows);
+	double_array_2d_col_sums(a,cols);
+	for (int i=0; i<4; i++) {
+		printf("Sum of row %d: %g\n", i+1, rows[i]);
+	}
+	for (int j=0; j<3; j++) {
+		printf("Sum of column %d: %g\n", j+1, cols[j]);
+	}
+	printf("Min: %g, max: %g\n", double_array_2d_min(a), double_array_2d_max(a));
+
+	double_array_2d_kill(a);
+	double_array_2d_kill(b);
+
+	return 0;
+}
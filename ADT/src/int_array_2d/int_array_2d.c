@@ -0,0 +1,407 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "int_array_2d.h"
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+/*
+ * Implementation of an integer 2D array for the "Datastructures and
+ * algorithms" courses at the Department of Computing Science, Umea
+ * University.
+ *
+ * Version information:
+ *   2026-10-17: v1.0, first public version.
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+// Alignment of each column, in bytes.
+#define ALIGNMENT 32
+
+struct int_array_2d {
+	int low[2]; // Low index limits.
+	int high[2]; // High index limits.
+	int rows; // Number of positions along the first dimension.
+	int cols; // Number of positions along the second dimension.
+	int stride; // Distance between columns, rows rounded up to ALIGNMENT.
+	int *keys; // Aligned pointer to where the actual keys are stored.
+	void *block; // Allocated memory holding the keys.
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+/*
+ * column() - Return a pointer to the first key of column c, counted
+ * from 0. The pointer is aligned to ALIGNMENT bytes.
+ */
+static int *column(const int_array_2d *a, int c)
+{
+	return a->keys + (size_t)c * a->stride;
+}
+
+#ifdef __AVX2__
+/*
+ * sum_lanes() - Return the sum of the four 64-bit lanes of x.
+ */
+static long long sum_lanes(__m256i x)
+{
+	__m128i s=_mm_add_epi64(_mm256_castsi256_si128(x),
+				_mm256_extracti128_si256(x, 1));
+	return _mm_cvtsi128_si64(s) + _mm_extract_epi64(s, 1);
+}
+#endif
+
+/*
+ * min_max() - Find the smallest and largest key in one pass.
+ */
+static void min_max(const int_array_2d *a, int *min, int *max)
+{
+	if (a->rows == 0 || a->cols == 0) {
+		*min=0;
+		*max=0;
+		return;
+	}
+	int lo=a->keys[0];
+	int hi=a->keys[0];
+#ifdef __AVX2__
+	__m256i vlo=_mm256_set1_epi32(lo);
+	__m256i vhi=vlo;
+#endif
+	for (int c=0; c<a->cols; c++) {
+		const int *k=column(a, c);
+		int i=0;
+#ifdef __AVX2__
+		for (; i+8<=a->rows; i+=8) {
+			__m256i x=_mm256_load_si256((const __m256i *)(k+i));
+			vlo=_mm256_min_epi32(vlo, x);
+			vhi=_mm256_max_epi32(vhi, x);
+		}
+#endif
+		for (; i<a->rows; i++) {
+			lo = k[i] < lo ? k[i] : lo;
+			hi = k[i] > hi ? k[i] : hi;
+		}
+	}
+#ifdef __AVX2__
+	int l[8];
+	int h[8];
+	_mm256_storeu_si256((__m256i *)l, vlo);
+	_mm256_storeu_si256((__m256i *)h, vhi);
+	for (int i=0; i<8; i++) {
+		lo = l[i] < lo ? l[i] : lo;
+		hi = h[i] > hi ? h[i] : hi;
+	}
+#endif
+	*min=lo;
+	*max=hi;
+}
+
+/**
+ * int_array_2d_create() - Create an array without keys.
+ * @lo1: low index limit for first dimension.
+ * @hi1: high index limit for first dimension.
+ * @lo2: low index limit for second dimension.
+ * @hi2: high index limit for second dimension.
+ *
+ * The index limits are inclusive, i.e. all indices i such that low <=
+ * i <= high are defined.
+ *
+ * Returns: A pointer to the new array, or NULL if not enough memory
+ * was available.
+ */
+int_array_2d *int_array_2d_create(int lo1, int hi1, int lo2, int hi2)
+{
+	// Allocate array structure.
+	int_array_2d *a=calloc(1, sizeof(*a));
+	if (a == NULL) {
+		return NULL;
+	}
+	// Store index limits.
+	a->low[0]=lo1;
+	a->low[1]=lo2;
+	a->high[0]=hi1;
+	a->high[1]=hi2;
+
+	a->rows=hi1-lo1+1;
+	a->cols=hi2-lo2+1;
+	// Round the columns up to whole vectors, so each one is aligned.
+	int per_vector=ALIGNMENT/sizeof(int);
+	a->stride=(a->rows+per_vector-1)/per_vector*per_vector;
+
+	size_t size=(size_t)a->stride * a->cols * sizeof(int);
+	a->block=calloc(size+ALIGNMENT, 1);
+
+	// Check whether the allocation succeeded.
+	if (a->block == NULL) {
+		free(a);
+		return NULL;
+	}
+	a->keys=(int *)(((uintptr_t)a->block + ALIGNMENT-1)
+			& ~(uintptr_t)(ALIGNMENT-1));
+	return a;
+}
+
+/**
+ * int_array_2d_low() - Return the low index limit for the array.
+ * @a: array to inspect.
+ * @d: dimension number, 1 or 2.
+ *
+ * Returns: The low index limit for dimension number d.
+ */
+int int_array_2d_low(const int_array_2d *a, int d)
+{
+	return a->low[d-1];
+}
+
+/**
+ * int_array_2d_high() - Return the high index limit for the array.
+ * @a: array to inspect.
+ * @d: dimension number, 1 or 2.
+ *
+ * Returns: The high index limit for dimension number d.
+ */
+int int_array_2d_high(const int_array_2d *a, int d)
+{
+	return a->high[d-1];
+}
+
+/**
+ * int_array_2d_inspect_key() - Inspect a key at a given array position.
+ * @a: array to inspect.
+ * @i: first index of position to inspect.
+ * @j: second index of position to inspect.
+ *
+ * Returns: The element key at the specified position, or 0 if no
+ *	    key is stored at that position.
+ */
+int int_array_2d_inspect_key(const int_array_2d *a, int i, int j)
+{
+	return column(a, j-a->low[1])[i-a->low[0]];
+}
+
+/**
+ * int_array_2d_has_key() - Check if a key is set at a given array position.
+ * @a: array to inspect.
+ * @i: first index of position to inspect.
+ * @j: second index of position to inspect.
+ *
+ * Returns: True if a key is set at the specified position, otherwise false.
+ */
+bool int_array_2d_has_key(const int_array_2d *a, int i, int j)
+{
+	return int_array_2d_inspect_key(a, i, j) != 0;
+}
+
+/**
+ * int_array_2d_set_key() - Set a key at a given array position.
+ * @a: array to modify.
+ * @v: key to set element to, or 0 to clear key.
+ * @i: first index of position to modify.
+ * @j: second index of position to modify.
+ *
+ * Returns: Nothing.
+ */
+void int_array_2d_set_key(int_array_2d *a, int v, int i, int j)
+{
+	column(a, j-a->low[1])[i-a->low[0]]=v;
+}
+
+/**
+ * int_array_2d_fill() - Set all positions to the same key.
+ * @a: array to modify.
+ * @v: key to set, or 0 to clear all keys.
+ *
+ * Returns: Nothing.
+ */
+void int_array_2d_fill(int_array_2d *a, int v)
+{
+#ifdef __AVX2__
+	__m256i x=_mm256_set1_epi32(v);
+#endif
+	for (int c=0; c<a->cols; c++) {
+		int *k=column(a, c);
+		int i=0;
+#ifdef __AVX2__
+		for (; i+8<=a->rows; i+=8) {
+			_mm256_store_si256((__m256i *)(k+i), x);
+		}
+#endif
+		for (; i<a->rows; i++) {
+			k[i]=v;
+		}
+	}
+}
+
+/**
+ * int_array_2d_add() - Add an array to another, element by element.
+ * @a: array to modify.
+ * @b: array to add. Must have the same index limits as a.
+ *
+ * A sum that does not fit in an int wraps around modulo 2^32.
+ *
+ * Returns: Nothing.
+ */
+void int_array_2d_add(int_array_2d *a, const int_array_2d *b)
+{
+	for (int c=0; c<a->cols; c++) {
+		int *k=column(a, c);
+		const int *l=column(b, c);
+		int i=0;
+#ifdef __AVX2__
+		for (; i+8<=a->rows; i+=8) {
+			__m256i x=_mm256_load_si256((const __m256i *)(k+i));
+			__m256i y=_mm256_load_si256((const __m256i *)(l+i));
+			_mm256_store_si256((__m256i *)(k+i),
+					   _mm256_add_epi32(x, y));
+		}
+#endif
+		// Add as unsigned, so an overflow wraps as in the
+		// vectorized add.
+		for (; i<a->rows; i++) {
+			k[i]=(int)((unsigned)k[i] + (unsigned)l[i]);
+		}
+	}
+}
+
+/**
+ * int_array_2d_min() - Return the smallest key in the array.
+ * @a: array to inspect.
+ *
+ * Returns: The smallest key, or 0 if the array has no positions.
+ */
+int int_array_2d_min(const int_array_2d *a)
+{
+	int min;
+	int max;
+	min_max(a, &min, &max);
+	return min;
+}
+
+/**
+ * int_array_2d_max() - Return the largest key in the array.
+ * @a: array to inspect.
+ *
+ * Returns: The largest key, or 0 if the array has no positions.
+ */
+int int_array_2d_max(const int_array_2d *a)
+{
+	int min;
+	int max;
+	min_max(a, &min, &max);
+	return max;
+}
+
+/**
+ * int_array_2d_row_sums() - Sum the keys along the second dimension.
+ * @a: array to inspect.
+ * @sums: room for one sum per first index.
+ *
+ * Sets sums[i-lo1] to the sum of the keys at (i,j) over all j.
+ *
+ * Returns: Nothing.
+ */
+void int_array_2d_row_sums(const int_array_2d *a, long long *sums)
+{
+	for (int i=0; i<a->rows; i++) {
+		sums[i]=0;
+	}
+	// Add one column at a time to all sums.
+	for (int c=0; c<a->cols; c++) {
+		const int *k=column(a, c);
+		int i=0;
+#ifdef __AVX2__
+		for (; i+4<=a->rows; i+=4) {
+			__m256i s=_mm256_loadu_si256((const __m256i *)(sums+i));
+			__m256i x=_mm256_cvtepi32_epi64(
+				_mm_load_si128((const __m128i *)(k+i)));
+			_mm256_storeu_si256((__m256i *)(sums+i),
+					    _mm256_add_epi64(s, x));
+		}
+#endif
+		for (; i<a->rows; i++) {
+			sums[i]+=k[i];
+		}
+	}
+}
+
+/**
+ * int_array_2d_col_sums() - Sum the keys along the first dimension.
+ * @a: array to inspect.
+ * @sums: room for one sum per second index.
+ *
+ * Sets sums[j-lo2] to the sum of the keys at (i,j) over all i.
+ *
+ * Returns: Nothing.
+ */
+void int_array_2d_col_sums(const int_array_2d *a, long long *sums)
+{
+	for (int c=0; c<a->cols; c++) {
+		const int *k=column(a, c);
+		long long s=0;
+		int i=0;
+#ifdef __AVX2__
+		// Widen to 64 bits before adding, so the sums cannot
+		// overflow.
+		__m256i s0=_mm256_setzero_si256();
+		__m256i s1=_mm256_setzero_si256();
+		for (; i+8<=a->rows; i+=8) {
+			__m256i x=_mm256_load_si256((const __m256i *)(k+i));
+			s0=_mm256_add_epi64(s0, _mm256_cvtepi32_epi64(
+					_mm256_castsi256_si128(x)));
+			s1=_mm256_add_epi64(s1, _mm256_cvtepi32_epi64(
+					_mm256_extracti128_si256(x, 1)));
+		}
+		s=sum_lanes(_mm256_add_epi64(s0, s1));
+#endif
+		for (; i<a->rows; i++) {
+			s+=k[i];
+		}
+		sums[c]=s;
+	}
+}
+
+/**
+ * int_array_2d_kill() - Return memory allocated by array.
+ * @a: array to kill.
+ *
+ * Returns: Nothing.
+ */
+void int_array_2d_kill(int_array_2d *a)
+{
+	// Free actual storage.
+	free(a->block);
+	// Free array structure.
+	free(a);
+}
+
+/**
+ * int_array_2d_print() - Iterate over the array element and print their keys.
+ * @a: Array to inspect.
+ *
+ * Iterates over each position in the array. Prints each non-zero element.
+ *
+ * Returns: Nothing.
+ */
+void int_array_2d_print(const int_array_2d *a)
+{
+	printf("[\n");
+	for (int i=int_array_2d_low(a,1); i<=int_array_2d_high(a,1); i++) {
+		printf(" [ ");
+		for (int j=int_array_2d_low(a,2); j<=int_array_2d_high(a,2); j++) {
+			if (int_array_2d_has_key(a,i,j)) {
+				printf("[%d]",int_array_2d_inspect_key(a,i,j));
+			} else {
+				printf("[  ]");
+			}
+			if (j<int_array_2d_high(a,2)) {
+				printf(", ");
+			}
+		}
+		printf(" ]\n");
+	}
+	printf(" ]\n");
+}
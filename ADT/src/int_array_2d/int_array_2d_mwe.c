@@ -0,0 +1,48 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "int_array_2d.h"
+
+/*
+ * Minimum working example for int_array_2d.c. Creates a 4-by-3 array
+ * with the key i*j at (i,j), adds a filled array to it, and prints the
+ * sums along each dimension and the smallest and largest key.
+ *
+ * Version information:
+ *   2026-10-17: v1.0, first public version.
+ */
+
+int main(void)
+{
+	// Create two 4-by-3 arrays.
+	int_array_2d *a = int_array_2d_create(1,4,1,3);
+	int_array_2d *b = int_array_2d_create(1,4,1,3);
+
+	for (int i=int_array_2d_low(a,1); i<=int_array_2d_high(a,1); i++) {
+		for (int j=int_array_2d_low(a,2); j<=int_array_2d_high(a,2); j++) {
+			int_array_2d_set_key(a,i*j,i,j);
+		}
+	}
+	int_array_2d_print(a);
+
+	// Add 10 to every key.
+	int_array_2d_fill(b,10);
+	int_array_2d_add(a,b);
+	int_array_2d_print(a);
+
+	long long rows[4];
+	long long cols[3];
+	int_array_2d_row_sums(a,rows);
+	int_array_2d_col_sums(a,cols);
+	for (int i=0; i<4; i++) {
+		printf("Sum of row %d: %lld\n", i+1, rows[i]);
+	}
+	for (int j=0; j<3; j++) {
+		printf("Sum of column %d: %lld\n", j+1, cols[j]);
+	}
+	printf("Min: %d, max: %d\n", int_array_2d_min(a), int_array_2d_max(a));
+
+	int_array_2d_kill(a);
+	int_array_2d_kill(b);
+
+	return 0;
+}
@@ -2,7 +2,6 @@
 #include <stdio.h>
 
 #include "table.h"
-#include "dlist.h"
 
 /*
  * Implementation of a generic table for the "Datastructures and
@@ -11,6 +10,12 @@
  *
  * Duplicates are handled by inspect and remove.
  *
+ * The entries form a singly linked list, newest first. Each entry
+ * holds its key, value and link, and is taken from slabs of entries
+ * owned by the table. Removed entries go to a free list and are
+ * reused, so an insert does not call malloc once the table has reached
+ * its working size.
+ *
  * Authors: Niclas Borlin (niclas@cs.umu.se)
  *	    Adam Dahlgren Lindstrom (dali@cs.umu.se)
  *
@@ -19,46 +24,166 @@
  * Version information:
  *   2018-02-06: v1.0, first public version.
  *   2019-03-04: v1.1, bugfix in table_remove.
+ *   2026-10-17: v1.2, fixed value parameters, added table_empty_hashed().
+ *   2026-10-17: v1.3, entries stored in table-owned slabs instead of
+ *		 a dlist.
+ *   2026-10-17: v1.4, added table_from_arrays().
+ *   2026-10-17: v1.5, added table_iter and table_drain().
  */
 
 // ===========INTERNAL DATA TYPES============
 
-struct table {
-	dlist *entries;
-	compare_function *key_cmp_func;
-	free_function key_free_func;
-	free_function key_free_func;
-};
+// Number of entries in the first slab. Each new slab is twice as
+// large as the previous one, up to MAX_SLAB_ENTRIES.
+#define MIN_SLAB_ENTRIES 16
+#define MAX_SLAB_ENTRIES 1024
 
 struct table_entry {
 	void *key;
-	void *key;
+	void *value;
+	struct table_entry *next;
+};
+
+struct table_slab {
+	struct table_slab *next;
+	struct table_entry entries[];
+};
+
+struct table {
+	struct table_entry *head; // First entry, the latest added.
+	struct table_entry *free_entries; // Unused entries.
+	struct table_slab *slabs; // All allocated slabs.
+	size_t slab_entries; // Number of entries in the next slab.
+	compare_function *key_cmp_func;
+	free_function key_free_func;
+	free_function value_free_func;
 };
 
 // ===========INTERNAL FUNCTION IMPLEMENTATIONS============
 
+/*
+ * entry_alloc() - Take an unused entry, allocating a new slab if none
+ * is left.
+ */
+static struct table_entry *entry_alloc(table *t)
+{
+	if (t->free_entries == NULL) {
+		size_t n = t->slab_entries;
+		struct table_slab *s = malloc(sizeof(*s)
+					      + n * sizeof(s->entries[0]));
+		// Put all entries of the new slab on the free list.
+		for (size_t i = 0; i < n; i++) {
+			s->entries[i].next = i + 1 < n ? &s->entries[i + 1]
+				: NULL;
+		}
+		t->free_entries = &s->entries[0];
+		s->next = t->slabs;
+		t->slabs = s;
+		if (n < MAX_SLAB_ENTRIES) {
+			t->slab_entries = 2 * n;
+		}
+	}
+	struct table_entry *e = t->free_entries;
+	t->free_entries = e->next;
+	return e;
+}
+
+/*
+ * entry_release() - Return an entry to the free list.
+ */
+static void entry_release(table *t, struct table_entry *e)
+{
+	e->next = t->free_entries;
+	t->free_entries = e;
+}
+
 /**
  * table_empty() - Create an empty table.
  * @key_cmp_func: A pointer to a function to be used to compare keys.
  * @key_free_func: A pointer to a function (or NULL) to be called to
  *		   de-allocate memory for keys on remove/kill.
- * @key_free_func: A pointer to a function (or NULL) to be called to
- *		     de-allocate memory for keys on remove/kill.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
  *
  * Returns: Pointer to a new table.
  */
 table *table_empty(compare_function *key_cmp_func, 
 		   free_function key_free_func,
-		   free_function key_free_func)
+		   free_function value_free_func)
 {
 	// Allocate the table header.
 	table *t = calloc(1, sizeof(table));
-	// Create the list to hold the table_entry-ies.
-	t->entries = dlist_empty(free);
-	// Store the key compare function and key/key free functions.
+	// The list starts empty. The first slab is allocated on the
+	// first insert.
+	t->slab_entries = MIN_SLAB_ENTRIES;
+	// Store the key compare function and key/value free functions.
 	t->key_cmp_func = key_cmp_func;
 	t->key_free_func = key_free_func;
-	t->key_free_func = key_free_func;
+	t->value_free_func = value_free_func;
+
+	return t;
+}
+
+/**
+ * table_empty_hashed() - Create an empty table.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_hash_func: Ignored. This implementation does not hash keys.
+ * @key_free_func: A pointer to a function (or NULL) to be called to
+ *		   de-allocate memory for keys on remove/kill.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty_hashed(compare_function *key_cmp_func,
+			  hash_function *key_hash_func,
+			  free_function key_free_func,
+			  free_function value_free_func)
+{
+	(void)key_hash_func;
+	return table_empty(key_cmp_func, key_free_func, value_free_func);
+}
+
+/**
+ * table_from_arrays() - Create a table holding n key/value pairs.
+ * @keys: Array of n key pointers.
+ * @values: Array of n value pointers.
+ * @n: Number of pairs.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_hash_func: Ignored. This implementation does not hash keys.
+ * @key_free_func: A pointer to a function (or NULL) to be called to
+ *		   de-allocate memory for keys on remove/kill.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
+ *
+ * Same as inserting the pairs in array order. All entries are taken
+ * from one slab of n entries, linked newest first.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_from_arrays(void **keys, void **values, int n,
+			 compare_function *key_cmp_func,
+			 hash_function *key_hash_func,
+			 free_function key_free_func,
+			 free_function value_free_func)
+{
+	(void)key_hash_func;
+	table *t = table_empty(key_cmp_func, key_free_func, value_free_func);
+
+	if (n <= 0) {
+		return t;
+	}
+	struct table_slab *s = malloc(sizeof(*s) + n * sizeof(s->entries[0]));
+	s->next = NULL;
+	t->slabs = s;
+	// Link each entry to the one before it, so the last pair comes
+	// first as if it had been inserted last.
+	for (int i = 0; i < n; i++) {
+		s->entries[i].key = keys[i];
+		s->entries[i].value = values[i];
+		s->entries[i].next = i > 0 ? &s->entries[i - 1] : NULL;
+	}
+	t->head = &s->entries[n - 1];
 
 	return t;
 }
@@ -67,36 +192,37 @@ table *table_empty(compare_function *key_cmp_func,
  * table_is_empty() - Check if a table is empty.
  * @table: Table to check.
  *
- * Returns: True if table contains no key/key pairs, false otherwise.
+ * Returns: True if table contains no key/value pairs, false otherwise.
  */
 bool table_is_empty(const table *t)
 {
-	return dlist_is_empty(t->entries);
+	return t->head == NULL;
 }
 
 /**
- * table_insert() - Add a key/key pair to a table.
+ * table_insert() - Add a key/value pair to a table.
  * @table: Table to manipulate.
- * @key: A pointer to the key key.
- * @key: A pointer to the key key.
+ * @key: A pointer to the key.
+ * @value: A pointer to the value.
  *
- * Insert the key/key pair into the table. No test is performed to
+ * Insert the key/value pair into the table. No test is performed to
  * check if key is a duplicate. table_lookup() will return the latest
- * added key for a duplicate key. table_remove() will remove all
+ * added value for a duplicate key. table_remove() will remove all
  * duplicates for a given key.
  *
  * Returns: Nothing.
  */
-void table_insert(table *t, void *key, void *key)
+void table_insert(table *t, void *key, void *value)
 {
-	// Allocate the key/key structure.
-	struct table_entry *entry = malloc(sizeof(struct table_entry));
+	// Take a key/value entry from the slabs.
+	struct table_entry *entry = entry_alloc(t);
 
 	// Set the pointers and insert first in the list. This will
-	// cause table_lookup() to find the latest added key.
-	entry->key = key;
+	// cause table_lookup() to find the latest added value.
 	entry->key = key;
-	dlist_insert(t->entries, entry, dlist_first(t->entries));
+	entry->value = value;
+	entry->next = t->head;
+	t->head = entry;
 }
 
 /**
@@ -104,26 +230,20 @@ void table_insert(table *t, void *key, void *key)
  * @table: Table to inspect.
  * @key: Key to look up.
  *
- * Returns: The key corresponding to a given key, or NULL if the key
+ * Returns: The value corresponding to a given key, or NULL if the key
  * is not found in the table. If the table contains duplicate keys,
- * the key that was latest inserted will be returned.
+ * the value that was latest inserted will be returned.
  */
 void *table_lookup(const table *t, const void *key)
 {
 	// Iterate over the list. Return first match.
-
-	dlist_pos pos = dlist_first(t->entries);
-
-	while (!dlist_is_end(t->entries, pos)) {
-		// Inspect the table entry
-		struct table_entry *entry = dlist_inspect(t->entries, pos);
+	for (struct table_entry *entry = t->head; entry != NULL;
+	     entry = entry->next) {
 		// Check if the entry key matches the search key.
 		if (t->key_cmp_func(entry->key, key) == 0) {
-			// If yes, return the corresponding key pointer.
-			return entry->key;
+			// If yes, return the corresponding value pointer.
+			return entry->value;
 		}
-		// Continue with the next position.
-		pos = dlist_next(t->entries, pos);
 	}
 	// No match found. Return NULL.
 	return NULL;
@@ -141,67 +261,65 @@ void *table_lookup(const table *t, const void *key)
  */
 void *table_choose_key(const table *t)
 {
-	// Return first key key.
-	dlist_pos pos = dlist_first(t->entries);
-	struct table_entry *entry = dlist_inspect(t->entries, pos);
-
-        return entry->key;
+	// Return first key.
+	return t->head->key;
 }
 
 /**
- * table_remove() - Remove a key/key pair in the table.
+ * table_remove() - Remove a key/value pair in the table.
  * @table: Table to manipulate.
  * @key: Key for which to remove pair.
  *
  * Any matching duplicates will be removed. Will call any free
- * functions set for keys/keys. Does nothing if key is not found in
+ * functions set for keys/values. Does nothing if key is not found in
  * the table.
  *
  * Returns: Nothing.
  */
 void table_remove(table *t, const void *key)
 {
-        // Will be set if we need to delay a free.
-        void *deferred_ptr = NULL;
-
-        // Start at beginning of the list.
-        dlist_pos pos = dlist_first(t->entries);
-
-        // Iterate over the list. Remove any entries with matching keys.
-        while (!dlist_is_end(t->entries, pos)) {
-                // Inspect the table entry
-                struct table_entry *entry = dlist_inspect(t->entries, pos);
-
-                // Compare the supplied key with the key of this entry.
-                if (t->key_cmp_func(entry->key, key) == 0) {
-                        // If we have a match, call free on the key
-                        // and/or key if given the responsiblity
-                        if (t->key_free_func != NULL) {
-                                if (entry->key == key) {
-                                        // The given key points to the same
-                                        // memory as entry->key. Freeing here
-                                        // would trigger a memory error in the
-                                        // next iteration. Instead, defer free
-                                        // of this pointer to the very end.
-                                        deferred_ptr = entry->key;
-                                } else {
-                                        t->key_free_func(entry->key);
-                                }
-                        }
-                        if (t->key_free_func != NULL) {
-                                t->key_free_func(entry->key);
-                        }
-                        // Remove the list element itself.
-                        pos = dlist_remove(t->entries, pos);
-                } else {
-                        // No match, move on to next element in the list.
-                        pos = dlist_next(t->entries, pos);
-                }
-        }
-        if (deferred_ptr != NULL) {
-                // Take care of the delayed free.
-                t->key_free_func(deferred_ptr);
-        }
+	// Will be set if we need to delay a free.
+	void *deferred_ptr = NULL;
+
+	// Start at beginning of the list. link points to the pointer to
+	// the current entry, so it can be unlinked.
+	struct table_entry **link = &t->head;
+
+	// Iterate over the list. Remove any entries with matching keys.
+	while (*link != NULL) {
+		struct table_entry *entry = *link;
+
+		// Compare the supplied key with the key of this entry.
+		if (t->key_cmp_func(entry->key, key) == 0) {
+			// If we have a match, call free on the key
+			// and/or value if given the responsiblity
+			if (t->key_free_func != NULL) {
+				if (entry->key == key) {
+					// The given key points to the same
+					// memory as entry->key. Freeing here
+					// would trigger a memory error in the
+					// next iteration. Instead, defer free
+					// of this pointer to the very end.
+					deferred_ptr = entry->key;
+				} else {
+					t->key_free_func(entry->key);
+				}
+			}
+			if (t->value_free_func != NULL) {
+				t->value_free_func(entry->value);
+			}
+			// Unlink the entry and return it to the slabs.
+			*link = entry->next;
+			entry_release(t, entry);
+		} else {
+			// No match, move on to next element in the list.
+			link = &entry->next;
+		}
+	}
+	if (deferred_ptr != NULL) {
+		// Take care of the delayed free.
+		t->key_free_func(deferred_ptr);
+	}
 }
 
 /*
@@ -209,33 +327,32 @@ void table_remove(table *t, const void *key)
  * @table: Table to destroy.
  *
  * Return all dynamic memory used by the table and its elements. If a
- * free_func was registered for keys and/or keys at table creation,
+ * free_func was registered for keys and/or values at table creation,
  * it is called each element to free any user-allocated memory
- * occupied by the element keys.
+ * occupied by the element keys and values.
  *
  * Returns: Nothing.
  */
 void table_kill(table *t)
 {
 	// Iterate over the list. Destroy all elements.
-	dlist_pos pos = dlist_first(t->entries);
-
-	while (!dlist_is_end(t->entries, pos)) {
-		// Inspect the key/key pair.
-		struct table_entry *entry = dlist_inspect(t->entries, pos);
-		// Free key and/or key if given the authority to do so.
+	for (struct table_entry *entry = t->head; entry != NULL;
+	     entry = entry->next) {
+		// Free key and/or value if given the authority to do so.
 		if (t->key_free_func != NULL) {
 			t->key_free_func(entry->key);
 		}
-		if (t->key_free_func != NULL) {
-			t->key_free_func(entry->key);
+		if (t->value_free_func != NULL) {
+			t->value_free_func(entry->value);
 		}
-		// Move on to next element.
-		pos = dlist_next(t->entries, pos);
 	}
 
-	// Kill what's left of the list...
-	dlist_kill(t->entries);
+	// Free the slabs...
+	while (t->slabs != NULL) {
+		struct table_slab *s = t->slabs;
+		t->slabs = s->next;
+		free(s);
+	}
 	// ...and the table.
 	free(t);
 }
@@ -243,22 +360,81 @@ void table_kill(table *t)
 /**
  * table_print() - Print the given table.
  * @t: Table to print.
- * @print_func: Function called for each key/key pair in the table.
+ * @print_func: Function called for each key/value pair in the table.
  *
- * Iterates over the key/key pairs in the table and prints them.
+ * Iterates over the key/value pairs in the table and prints them.
  * Will print all stored elements, including duplicates.
  *
  * Returns: Nothing.
  */
 void table_print(const table *t, inspect_callback_pair print_func)
 {
-	// Iterate over all elements. Call print_func on keys/keys.
-	dlist_pos pos = dlist_first(t->entries);
-
-	while (!dlist_is_end(t->entries, pos)) {
-		struct table_entry *e = dlist_inspect(t->entries, pos);
-		// Call print_func
-		print_func(e->key, e->key);
-		pos = dlist_next(t->entries, pos);
+	// Iterate over all elements. Call print_func on keys/values.
+	for (struct table_entry *e = t->head; e != NULL; e = e->next) {
+		print_func(e->key, e->value);
+	}
+}
+
+/**
+ * table_iter_begin() - Start iterating over the pairs of a table.
+ * @t: Table to inspect.
+ * @it: Iterator to set up.
+ *
+ * Visits the pairs in list order, i.e. the latest added first. Any
+ * insert or remove invalidates the iterator.
+ *
+ * Returns: Nothing.
+ */
+void table_iter_begin(const table *t, table_iter *it)
+{
+	it->t = t;
+	it->next = t->head;
+}
+
+/**
+ * table_iter_next() - Advance an iterator to the next pair.
+ * @it: Iterator to advance.
+ * @key: Set to the key of the pair.
+ * @value: Set to the value of the pair.
+ *
+ * Returns: True if a pair was found, false when all pairs have been
+ * visited.
+ */
+bool table_iter_next(table_iter *it, void **key, void **value)
+{
+	struct table_entry *e = it->next;
+
+	if (e == NULL) {
+		return false;
+	}
+	*key = e->key;
+	*value = e->value;
+	it->next = e->next;
+	return true;
+}
+
+/**
+ * table_drain() - Remove one pair from a table and hand it over.
+ * @t: Table to manipulate.
+ * @key: Set to the key of the removed pair.
+ * @value: Set to the value of the removed pair.
+ *
+ * Removes the latest added pair. The free functions are not called:
+ * the caller takes over the key and value.
+ *
+ * Returns: True if a pair was removed, false if the table was empty.
+ */
+bool table_drain(table *t, void **key, void **value)
+{
+	struct table_entry *e = t->head;
+
+	if (e == NULL) {
+		return false;
 	}
+	*key = e->key;
+	*value = e->value;
+	// Unlink the entry and return it to the slabs.
+	t->head = e->next;
+	entry_release(t, e);
+	return true;
 }
@@ -20,6 +20,9 @@
  *   2018-02-06: v1.0, first public version.
  *   2019-02-21: v1.1, second version without dlist/memfreehandler.
  *   2019-03-04: v1.2, bugfix in table_remove.
+ *   2026-10-17: v1.3, fixed value parameters, added table_empty_hashed().
+ *   2026-10-17: v1.4, added table_from_arrays().
+ *   2026-10-17: v1.5, added table_iter and table_drain().
  */
 
 // ===========INTERNAL DATA TYPES============
@@ -28,12 +31,12 @@ struct table {
 	dlist *entries;
 	compare_function *key_cmp_func;
 	free_function key_free_func;
-	free_function key_free_func;
+	free_function value_free_func;
 };
 
 struct table_entry {
 	void *key;
-	void *key;
+	void *value;
 };
 
 // ===========INTERNAL FUNCTION IMPLEMENTATIONS============
@@ -43,32 +46,84 @@ struct table_entry {
  * @key_cmp_func: A pointer to a function to be used to compare keys.
  * @key_free_func: A pointer to a function (or NULL) to be called to
  *		   de-allocate memory for keys on remove/kill.
- * @key_free_func: A pointer to a function (or NULL) to be called to
- *		     de-allocate memory for keys on remove/kill.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
  *
  * Returns: Pointer to a new table.
  */
 table *table_empty(compare_function *key_cmp_func,
 		   free_function key_free_func,
-		   free_function key_free_func)
+		   free_function value_free_func)
 {
 	// Allocate the table header.
 	table *t = calloc(1, sizeof(table));
 	// Create the list to hold the table_entry-ies.
 	t->entries = dlist_empty(NULL);
-	// Store the key compare function and key/key free functions.
+	// Store the key compare function and key/value free functions.
 	t->key_cmp_func = key_cmp_func;
 	t->key_free_func = key_free_func;
-	t->key_free_func = key_free_func;
+	t->value_free_func = value_free_func;
 
 	return t;
 }
 
+/**
+ * table_empty_hashed() - Create an empty table.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_hash_func: Ignored. This implementation does not hash keys.
+ * @key_free_func: A pointer to a function (or NULL) to be called to
+ *		   de-allocate memory for keys on remove/kill.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty_hashed(compare_function *key_cmp_func,
+			  hash_function *key_hash_func,
+			  free_function key_free_func,
+			  free_function value_free_func)
+{
+	(void)key_hash_func;
+	return table_empty(key_cmp_func, key_free_func, value_free_func);
+}
+
+/**
+ * table_from_arrays() - Create a table holding n key/value pairs.
+ * @keys: Array of n key pointers.
+ * @values: Array of n value pointers.
+ * @n: Number of pairs.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_hash_func: Ignored. This implementation does not hash keys.
+ * @key_free_func: A pointer to a function (or NULL) to be called to
+ *		   de-allocate memory for keys on remove/kill.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
+ *
+ * Same as inserting the pairs in array order. The list allocates each
+ * element separately, so this saves no allocations.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_from_arrays(void **keys, void **values, int n,
+			 compare_function *key_cmp_func,
+			 hash_function *key_hash_func,
+			 free_function key_free_func,
+			 free_function value_free_func)
+{
+	(void)key_hash_func;
+	table *t = table_empty(key_cmp_func, key_free_func, value_free_func);
+
+	for (int i = 0; i < n; i++) {
+		table_insert(t, keys[i], values[i]);
+	}
+	return t;
+}
+
 /**
  * table_is_empty() - Check if a table is empty.
  * @table: Table to check.
  *
- * Returns: True if table contains no key/key pairs, false otherwise.
+ * Returns: True if table contains no key/value pairs, false otherwise.
  */
 bool table_is_empty(const table *t)
 {
@@ -76,27 +131,27 @@ bool table_is_empty(const table *t)
 }
 
 /**
- * table_insert() - Add a key/key pair to a table.
+ * table_insert() - Add a key/value pair to a table.
  * @table: Table to manipulate.
- * @key: A pointer to the key key.
- * @key: A pointer to the key key.
+ * @key: A pointer to the key.
+ * @value: A pointer to the value.
  *
- * Insert the key/key pair into the table. No test is performed to
+ * Insert the key/value pair into the table. No test is performed to
  * check if key is a duplicate. table_lookup() will return the latest
- * added key for a duplicate key. table_remove() will remove all
+ * added value for a duplicate key. table_remove() will remove all
  * duplicates for a given key.
  *
  * Returns: Nothing.
  */
-void table_insert(table *t, void *key, void *key)
+void table_insert(table *t, void *key, void *value)
 {
-	// Allocate the key/key structure.
+	// Allocate the key/value structure.
 	struct table_entry *entry = malloc(sizeof(struct table_entry));
 
 	// Set the pointers and insert first in the list. This will
-	// cause table_lookup() to find the latest added key.
-	entry->key = key;
+	// cause table_lookup() to find the latest added value.
 	entry->key = key;
+	entry->value = value;
 	dlist_insert(t->entries, entry, dlist_first(t->entries));
 }
 
@@ -105,9 +160,9 @@ void table_insert(table *t, void *key, void *key)
  * @table: Table to inspect.
  * @key: Key to look up.
  *
- * Returns: The key corresponding to a given key, or NULL if the key
+ * Returns: The value corresponding to a given key, or NULL if the key
  * is not found in the table. If the table contains duplicate keys,
- * the key that was latest inserted will be returned.
+ * the value that was latest inserted will be returned.
  */
 void *table_lookup(const table *t, const void *key)
 {
@@ -120,8 +175,8 @@ void *table_lookup(const table *t, const void *key)
 		struct table_entry *entry = dlist_inspect(t->entries, pos);
 		// Check if the entry key matches the search key.
 		if (t->key_cmp_func(entry->key, key) == 0) {
-			// If yes, return the corresponding key pointer.
-			return entry->key;
+			// If yes, return the corresponding value pointer.
+			return entry->value;
 		}
 		// Continue with the next position.
 		pos = dlist_next(t->entries, pos);
@@ -142,7 +197,7 @@ void *table_lookup(const table *t, const void *key)
  */
 void *table_choose_key(const table *t)
 {
-	// Return first key key.
+	// Return first key.
 	dlist_pos pos = dlist_first(t->entries);
 	struct table_entry *entry = dlist_inspect(t->entries, pos);
 
@@ -150,12 +205,12 @@ void *table_choose_key(const table *t)
 }
 
 /**
- * table_remove() - Remove a key/key pair in the table.
+ * table_remove() - Remove a key/value pair in the table.
  * @table: Table to manipulate.
  * @key: Key for which to remove pair.
  *
  * Any matching duplicates will be removed. Will call any free
- * functions set for keys/keys. Does nothing if key is not found in
+ * functions set for keys/values. Does nothing if key is not found in
  * the table.
  *
  * Returns: Nothing.
@@ -176,7 +231,7 @@ void table_remove(table *t, const void *key)
 		// Compare the supplied key with the key of this entry.
 		if (t->key_cmp_func(entry->key, key) == 0) {
 			// If we have a match, call free on the key
-			// and/or key if given the responsiblity
+			// and/or value if given the responsiblity
 			if (t->key_free_func != NULL) {
                                 if (entry->key == key) {
                                         // The given key points to the same
@@ -189,8 +244,8 @@ void table_remove(table *t, const void *key)
 				t->key_free_func(entry->key);
 			}
                         }
-			if (t->key_free_func != NULL) {
-				t->key_free_func(entry->key);
+			if (t->value_free_func != NULL) {
+				t->value_free_func(entry->value);
 			}
 			// Remove the list element itself.
 			pos = dlist_remove(t->entries, pos);
@@ -212,9 +267,9 @@ void table_remove(table *t, const void *key)
  * @table: Table to destroy.
  *
  * Return all dynamic memory used by the table and its elements. If a
- * free_func was registered for keys and/or keys at table creation,
+ * free_func was registered for keys and/or values at table creation,
  * it is called each element to free any user-allocated memory
- * occupied by the element keys.
+ * occupied by the element keys and values.
  *
  * Returns: Nothing.
  */
@@ -224,14 +279,14 @@ void table_kill(table *t)
 	dlist_pos pos = dlist_first(t->entries);
 
 	while (!dlist_is_end(t->entries, pos)) {
-		// Inspect the key/key pair.
+		// Inspect the key/value pair.
 		struct table_entry *entry = dlist_inspect(t->entries, pos);
-		// Free key and/or key if given the authority to do so.
+		// Free key and/or value if given the authority to do so.
 		if (t->key_free_func != NULL) {
 			t->key_free_func(entry->key);
 		}
-		if (t->key_free_func != NULL) {
-			t->key_free_func(entry->key);
+		if (t->value_free_func != NULL) {
+			t->value_free_func(entry->value);
 		}
 		// Move on to next element.
 		pos = dlist_next(t->entries, pos);
@@ -248,22 +303,88 @@ void table_kill(table *t)
 /**
  * table_print() - Print the given table.
  * @t: Table to print.
- * @print_func: Function called for each key/key pair in the table.
+ * @print_func: Function called for each key/value pair in the table.
  *
- * Iterates over the key/key pairs in the table and prints them.
+ * Iterates over the key/value pairs in the table and prints them.
  * Will print all stored elements, including duplicates.
  *
  * Returns: Nothing.
  */
 void table_print(const table *t, inspect_callback_pair print_func)
 {
-	// Iterate over all elements. Call print_func on keys/keys.
+	// Iterate over all elements. Call print_func on keys/values.
 	dlist_pos pos = dlist_first(t->entries);
 
 	while (!dlist_is_end(t->entries, pos)) {
 		struct table_entry *e = dlist_inspect(t->entries, pos);
 		// Call print_func
-		print_func(e->key, e->key);
+		print_func(e->key, e->value);
 		pos = dlist_next(t->entries, pos);
 	}
 }
+
+/**
+ * table_iter_begin() - Start iterating over the pairs of a table.
+ * @t: Table to inspect.
+ * @it: Iterator to set up.
+ *
+ * Visits the pairs in list order, i.e. the latest added first. Any
+ * insert or remove invalidates the iterator.
+ *
+ * Returns: Nothing.
+ */
+void table_iter_begin(const table *t, table_iter *it)
+{
+	it->t = t;
+	it->next = dlist_first(t->entries);
+}
+
+/**
+ * table_iter_next() - Advance an iterator to the next pair.
+ * @it: Iterator to advance.
+ * @key: Set to the key of the pair.
+ * @value: Set to the value of the pair.
+ *
+ * Returns: True if a pair was found, false when all pairs have been
+ * visited.
+ */
+bool table_iter_next(table_iter *it, void **key, void **value)
+{
+	dlist_pos pos = it->next;
+
+	if (dlist_is_end(it->t->entries, pos)) {
+		return false;
+	}
+	struct table_entry *entry = dlist_inspect(it->t->entries, pos);
+	*key = entry->key;
+	*value = entry->value;
+	it->next = dlist_next(it->t->entries, pos);
+	return true;
+}
+
+/**
+ * table_drain() - Remove one pair from a table and hand it over.
+ * @t: Table to manipulate.
+ * @key: Set to the key of the removed pair.
+ * @value: Set to the value of the removed pair.
+ *
+ * Removes the latest added pair. The free functions are not called:
+ * the caller takes over the key and value.
+ *
+ * Returns: True if a pair was removed, false if the table was empty.
+ */
+bool table_drain(table *t, void **key, void **value)
+{
+	dlist_pos pos = dlist_first(t->entries);
+
+	if (dlist_is_end(t->entries, pos)) {
+		return false;
+	}
+	struct table_entry *entry = dlist_inspect(t->entries, pos);
+	*key = entry->key;
+	*value = entry->value;
+	// Remove the list element and the entry itself.
+	dlist_remove(t->entries, pos);
+	free(entry);
+	return true;
+}
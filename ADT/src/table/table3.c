@@ -0,0 +1,535 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+
+#include "table.h"
+
+/*
+ * Implementation of a generic table for the "Datastructures and
+ * algorithms" courses at the Department of Computing Science, Umea
+ * University. This version hashes the keys into an open addressing
+ * array, so lookup, insert and remove take O(1) expected time instead
+ * of scanning all entries. Keys are hashed with the hash_function
+ * given to table_empty_hashed(). Without one, all keys share one
+ * probe chain and the table degrades to a linear scan.
+ *
+ * Duplicates are handled by inspect and remove. All duplicates of a
+ * key lie on the same probe chain, newest first, so a lookup returns
+ * the latest added value by stopping at the first match.
+ *
+ * Version information:
+ *   2026-10-17: v1.0, first version.
+ *   2026-10-17: v1.1, added table_from_arrays().
+ *   2026-10-17: v1.2, added table_iter and table_drain().
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+// 2^64 / phi. Multiplying by it spreads simple hash values, e.g. of
+// consecutive integers, over the whole array.
+#define FIB_MULT 0x9e3779b97f4a7c15ULL
+
+// Smallest number of slots.
+#define MIN_CAPACITY 16
+
+// Hash value marking a free slot.
+#define HASH_FREE 0
+
+struct table_entry {
+	void *key;
+	void *value;
+	uint64_t hash; // Mixed key hash, HASH_FREE if the slot is free.
+};
+
+struct table {
+	struct table_entry *entries; // Slots, a power of two of them.
+	size_t capacity; // Number of slots.
+	size_t size; // Number of stored entries, duplicates included.
+	size_t lowest; // No entry is stored before this slot.
+	int shift; // 64 - log2(capacity).
+	compare_function *key_cmp_func;
+	hash_function *key_hash_func;
+	free_function key_free_func;
+	free_function value_free_func;
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+/*
+ * key_hash() - Compute the mixed hash of a key. Never HASH_FREE.
+ */
+static uint64_t key_hash(const table *t, const void *key)
+{
+	uint64_t h = 0;
+
+	if (t->key_hash_func != NULL) {
+		h = t->key_hash_func(key);
+	}
+	h *= FIB_MULT;
+	return h != HASH_FREE ? h : 1;
+}
+
+/*
+ * home_slot() - Return the slot where probing for hash h starts.
+ */
+static size_t home_slot(const table *t, uint64_t h)
+{
+	return h >> t->shift;
+}
+
+/*
+ * store_entry() - Place an entry in the first free slot of its chain.
+ */
+static void store_entry(table *t, struct table_entry e)
+{
+	size_t mask = t->capacity - 1;
+	size_t i = home_slot(t, e.hash);
+
+	while (t->entries[i].hash != HASH_FREE) {
+		i = (i + 1) & mask;
+	}
+	t->entries[i] = e;
+	if (i < t->lowest) {
+		t->lowest = i;
+	}
+}
+
+/*
+ * set_capacity() - Move all entries to a new array of n slots.
+ *
+ * The old slots are visited in chain order starting after a free slot,
+ * so duplicates keep their newest-first order.
+ */
+static void set_capacity(table *t, size_t n)
+{
+	struct table_entry *old = t->entries;
+	size_t old_n = t->capacity;
+	size_t start = 0;
+
+	t->entries = calloc(n, sizeof(*t->entries));
+	t->capacity = n;
+	t->lowest = n;
+	for (t->shift = 64; n > 1; n /= 2) {
+		t->shift--;
+	}
+	while (start < old_n && old[start].hash != HASH_FREE) {
+		start++;
+	}
+	for (size_t k = 1; k <= old_n; k++) {
+		struct table_entry *e = &old[(start + k) % old_n];
+		if (e->hash != HASH_FREE) {
+			store_entry(t, *e);
+		}
+	}
+	free(old);
+}
+
+/*
+ * erase_slot() - Free slot i and shift the rest of its chain back.
+ *
+ * An entry may only move back if the hole is not before its home
+ * slot. Moved entries keep their relative order.
+ */
+static void erase_slot(table *t, size_t hole)
+{
+	size_t mask = t->capacity - 1;
+
+	for (size_t i = (hole + 1) & mask; t->entries[i].hash != HASH_FREE;
+	     i = (i + 1) & mask) {
+		size_t home = home_slot(t, t->entries[i].hash);
+		if (((i - home) & mask) >= ((i - hole) & mask)) {
+			t->entries[hole] = t->entries[i];
+			hole = i;
+		}
+	}
+	t->entries[hole].hash = HASH_FREE;
+	t->entries[hole].key = NULL;
+	t->entries[hole].value = NULL;
+	t->size--;
+}
+
+/*
+ * find_slot() - Return the slot of the latest added entry for key, or
+ * the capacity if the key is not found.
+ */
+static size_t find_slot(const table *t, const void *key)
+{
+	size_t mask = t->capacity - 1;
+	uint64_t h = key_hash(t, key);
+
+	for (size_t i = home_slot(t, h); t->entries[i].hash != HASH_FREE;
+	     i = (i + 1) & mask) {
+		if (t->entries[i].hash == h
+		    && t->key_cmp_func(t->entries[i].key, key) == 0) {
+			return i;
+		}
+	}
+	return t->capacity;
+}
+
+/**
+ * table_empty_hashed() - Create an empty table that hashes its keys.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_hash_func: A pointer to a function (or NULL) to be used to hash
+ *		   keys.
+ * @key_free_func: A pointer to a function (or NULL) to be called to
+ *		   de-allocate memory for keys on remove/kill.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty_hashed(compare_function *key_cmp_func,
+			  hash_function *key_hash_func,
+			  free_function key_free_func,
+			  free_function value_free_func)
+{
+	// Allocate the table header.
+	table *t = calloc(1, sizeof(table));
+	// Store the key compare and hash functions and key/value free
+	// functions.
+	t->key_cmp_func = key_cmp_func;
+	t->key_hash_func = key_hash_func;
+	t->key_free_func = key_free_func;
+	t->value_free_func = value_free_func;
+	// Allocate the slots.
+	set_capacity(t, MIN_CAPACITY);
+
+	return t;
+}
+
+/**
+ * table_from_arrays() - Create a table holding n key/value pairs.
+ * @keys: Array of n key pointers.
+ * @values: Array of n value pointers.
+ * @n: Number of pairs.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_hash_func: A pointer to a function (or NULL) to be used to hash
+ *		   keys.
+ * @key_free_func: A pointer to a function (or NULL) to be called to
+ *		   de-allocate memory for keys on remove/kill.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
+ *
+ * Same as inserting the pairs in array order, but the slots are
+ * allocated once, large enough for all n pairs.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_from_arrays(void **keys, void **values, int n,
+			 compare_function *key_cmp_func,
+			 hash_function *key_hash_func,
+			 free_function key_free_func,
+			 free_function value_free_func)
+{
+	table *t = table_empty_hashed(key_cmp_func, key_hash_func,
+				      key_free_func, value_free_func);
+	size_t capacity = t->capacity;
+
+	// Stay below the load factor of 3/4 that triggers growth.
+	while (4 * (size_t)n > 3 * capacity) {
+		capacity *= 2;
+	}
+	if (capacity > t->capacity) {
+		set_capacity(t, capacity);
+	}
+	for (int i = 0; i < n; i++) {
+		table_insert(t, keys[i], values[i]);
+	}
+	return t;
+}
+
+/**
+ * table_empty() - Create an empty table.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_free_func: A pointer to a function (or NULL) to be called to
+ *		   de-allocate memory for keys on remove/kill.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
+ *
+ * Without a hash function all keys share one probe chain. Use
+ * table_empty_hashed() to get constant time operations.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty(compare_function *key_cmp_func,
+		   free_function key_free_func,
+		   free_function value_free_func)
+{
+	return table_empty_hashed(key_cmp_func, NULL, key_free_func,
+				  value_free_func);
+}
+
+/**
+ * table_is_empty() - Check if a table is empty.
+ * @table: Table to check.
+ *
+ * Returns: True if table contains no key/value pairs, false otherwise.
+ */
+bool table_is_empty(const table *t)
+{
+	return t->size == 0;
+}
+
+/**
+ * table_insert() - Add a key/value pair to a table.
+ * @table: Table to manipulate.
+ * @key: A pointer to the key.
+ * @value: A pointer to the value.
+ *
+ * Insert the key/value pair into the table. No test is performed to
+ * check if key is a duplicate. table_lookup() will return the latest
+ * added value for a duplicate key. table_remove() will remove all
+ * duplicates for a given key.
+ *
+ * Returns: Nothing.
+ */
+void table_insert(table *t, void *key, void *value)
+{
+	// Grow at a load factor of 3/4.
+	if (4 * (t->size + 1) > 3 * t->capacity) {
+		set_capacity(t, 2 * t->capacity);
+	}
+
+	struct table_entry e = { key, value, key_hash(t, key) };
+	size_t mask = t->capacity - 1;
+	size_t i = home_slot(t, e.hash);
+
+	// Walk the chain. Each duplicate met is swapped out for the entry
+	// being placed, which then moves on. This keeps the duplicates
+	// newest first, so table_lookup() finds the latest one.
+	while (t->entries[i].hash != HASH_FREE) {
+		if (t->entries[i].hash == e.hash
+		    && t->key_cmp_func(t->entries[i].key, key) == 0) {
+			struct table_entry older = t->entries[i];
+			t->entries[i] = e;
+			e = older;
+		}
+		i = (i + 1) & mask;
+	}
+	t->entries[i] = e;
+	if (i < t->lowest) {
+		t->lowest = i;
+	}
+	t->size++;
+}
+
+/**
+ * table_lookup() - Look up a given key in a table.
+ * @table: Table to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: The value corresponding to a given key, or NULL if the key
+ * is not found in the table. If the table contains duplicate keys,
+ * the value that was latest inserted will be returned.
+ */
+void *table_lookup(const table *t, const void *key)
+{
+	size_t i = find_slot(t, key);
+
+	return i < t->capacity ? t->entries[i].value : NULL;
+}
+
+/**
+ * table_choose_key() - Return an arbitrary key.
+ * @t: Table to inspect.
+ *
+ * Return an arbitrary key stored in the table. Can be used together
+ * with table_remove() to deconstruct the table. Undefined for an
+ * empty table.
+ *
+ * Returns: An arbitrary key stored in the table.
+ */
+void *table_choose_key(const table *t)
+{
+	// Return the key of the first used slot. No slot before lowest
+	// is used, so deconstructing the table does not rescan them.
+	size_t i = t->lowest;
+
+	while (t->entries[i].hash == HASH_FREE) {
+		i++;
+	}
+	return t->entries[i].key;
+}
+
+/**
+ * table_remove() - Remove a key/value pair in the table.
+ * @table: Table to manipulate.
+ * @key: Key for which to remove pair.
+ *
+ * Any matching duplicates will be removed. Will call any free
+ * functions set for keys/values. Does nothing if key is not found in
+ * the table.
+ *
+ * Returns: Nothing.
+ */
+void table_remove(table *t, const void *key)
+{
+	// Will be set if we need to delay a free.
+	void *deferred_ptr = NULL;
+	size_t mask = t->capacity - 1;
+	uint64_t h = key_hash(t, key);
+	size_t i = find_slot(t, key);
+
+	// All duplicates follow the first match on the same chain.
+	while (i < t->capacity && t->entries[i].hash != HASH_FREE) {
+		struct table_entry *e = &t->entries[i];
+
+		if (e->hash != h || t->key_cmp_func(e->key, key) != 0) {
+			i = (i + 1) & mask;
+			continue;
+		}
+		// If we have a match, call free on the key and/or value
+		// if given the responsiblity.
+		if (t->key_free_func != NULL) {
+			if (e->key == key) {
+				// The given key points to the same memory
+				// as e->key. Freeing here would trigger a
+				// memory error in the next comparison.
+				// Instead, defer free of this pointer to
+				// the very end.
+				deferred_ptr = e->key;
+			} else {
+				t->key_free_func(e->key);
+			}
+		}
+		if (t->value_free_func != NULL) {
+			t->value_free_func(e->value);
+		}
+		// Free the slot. The next entry of the chain may have
+		// been shifted into it, so look at the same slot again.
+		erase_slot(t, i);
+	}
+	// Skip past slots freed at the start of the array.
+	while (t->lowest < t->capacity
+	       && t->entries[t->lowest].hash == HASH_FREE) {
+		t->lowest++;
+	}
+	if (deferred_ptr != NULL) {
+		// Take care of the delayed free.
+		t->key_free_func(deferred_ptr);
+	}
+}
+
+/*
+ * table_kill() - Destroy a table.
+ * @table: Table to destroy.
+ *
+ * Return all dynamic memory used by the table and its elements. If a
+ * free_func was registered for keys and/or values at table creation,
+ * it is called each element to free any user-allocated memory
+ * occupied by the element keys and values.
+ *
+ * Returns: Nothing.
+ */
+void table_kill(table *t)
+{
+	// Iterate over the slots. Destroy all elements.
+	for (size_t i = 0; i < t->capacity; i++) {
+		struct table_entry *e = &t->entries[i];
+		if (e->hash == HASH_FREE) {
+			continue;
+		}
+		// Free key and/or value if given the authority to do so.
+		if (t->key_free_func != NULL) {
+			t->key_free_func(e->key);
+		}
+		if (t->value_free_func != NULL) {
+			t->value_free_func(e->value);
+		}
+	}
+
+	// Free the slots...
+	free(t->entries);
+	// ...and the table.
+	free(t);
+}
+
+/**
+ * table_print() - Print the given table.
+ * @t: Table to print.
+ * @print_func: Function called for each key/value pair in the table.
+ *
+ * Iterates over the key/value pairs in the table and prints them.
+ * Will print all stored elements, including duplicates.
+ *
+ * Returns: Nothing.
+ */
+void table_print(const table *t, inspect_callback_pair print_func)
+{
+	// Iterate over all slots. Call print_func on keys/values.
+	for (size_t i = 0; i < t->capacity; i++) {
+		struct table_entry *e = &t->entries[i];
+		if (e->hash != HASH_FREE) {
+			print_func(e->key, e->value);
+		}
+	}
+}
+
+/**
+ * table_iter_begin() - Start iterating over the pairs of a table.
+ * @t: Table to inspect.
+ * @it: Iterator to set up.
+ *
+ * Visits the pairs in slot order. Any insert or remove invalidates the
+ * iterator.
+ *
+ * Returns: Nothing.
+ */
+void table_iter_begin(const table *t, table_iter *it)
+{
+	it->t = t;
+	it->idx[0] = t->lowest;
+}
+
+/**
+ * table_iter_next() - Advance an iterator to the next pair.
+ * @it: Iterator to advance.
+ * @key: Set to the key of the pair.
+ * @value: Set to the value of the pair.
+ *
+ * Returns: True if a pair was found, false when all pairs have been
+ * visited.
+ */
+bool table_iter_next(table_iter *it, void **key, void **value)
+{
+	const table *t = it->t;
+
+	for (size_t i = it->idx[0]; i < t->capacity; i++) {
+		if (t->entries[i].hash != HASH_FREE) {
+			*key = t->entries[i].key;
+			*value = t->entries[i].value;
+			it->idx[0] = i + 1;
+			return true;
+		}
+	}
+	it->idx[0] = t->capacity;
+	return false;
+}
+
+/**
+ * table_drain() - Remove one pair from a table and hand it over.
+ * @t: Table to manipulate.
+ * @key: Set to the key of the removed pair.
+ * @value: Set to the value of the removed pair.
+ *
+ * Removes the pair in the first used slot. The free functions are not
+ * called: the caller takes over the key and value. No slot before
+ * lowest is used, so draining the whole table scans the slots once.
+ *
+ * Returns: True if a pair was removed, false if the table was empty.
+ */
+bool table_drain(table *t, void **key, void **value)
+{
+	if (t->size == 0) {
+		return false;
+	}
+	while (t->entries[t->lowest].hash == HASH_FREE) {
+		t->lowest++;
+	}
+	*key = t->entries[t->lowest].key;
+	*value = t->entries[t->lowest].value;
+	// The rest of the chain may shift into the slot, so lowest stays.
+	erase_slot(t, t->lowest);
+	return true;
+}
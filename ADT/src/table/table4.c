@@ -0,0 +1,1027 @@
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "table.h"
+#include "ordered_table.h"
+
+/*
+ * Implementation of a generic table for the "Datastructures and
+ * algorithms" courses at the Department of Computing Science, Umea
+ * University. This version keeps the keys sorted by the compare
+ * function in a B-tree. Each node holds up to MAX_ITEMS keys in one
+ * array, so a search reads a few wide nodes instead of one node per
+ * key. Lookup, insert and remove take O(log n) time. On top of the
+ * table.h interface, the functions in ordered_table.h answer ordered
+ * queries: min, max, floor, ceiling and range.
+ *
+ * Duplicates are handled by inspect and remove. Each key is stored
+ * once in the tree. Older values of a duplicate key are kept in a list
+ * hanging off its item, newest first.
+ *
+ * Version information:
+ *   2026-10-17: v1.0, first version.
+ *   2026-10-17: v1.1, added table_from_arrays().
+ *   2026-10-17: v1.2, added table_iter and table_drain().
+ */
+
+// ===========INTERNAL DATA TYPES============
+
+// Minimum degree. Nodes other than the root hold between MIN_DEGREE - 1
+// and MAX_ITEMS items.
+#define MIN_DEGREE 16
+#define MAX_ITEMS (2 * MIN_DEGREE - 1)
+
+// An older key/value pair of a duplicate key.
+struct table_dup {
+	void *key;
+	void *value;
+	struct table_dup *next;
+};
+
+// A key with its latest value.
+struct table_item {
+	void *key;
+	void *value;
+	struct table_dup *older; // Older duplicates, newest first.
+};
+
+struct btree_node {
+	int n; // Number of items.
+	bool leaf;
+	struct table_item items[MAX_ITEMS];
+	// The keys of child[i] lie between items[i - 1] and items[i].
+	struct btree_node *child[MAX_ITEMS + 1];
+};
+
+struct table {
+	struct btree_node *root;
+	compare_function *key_cmp_func;
+	free_function key_free_func;
+	free_function value_free_func;
+};
+
+// ===========INTERNAL FUNCTION IMPLEMENTATIONS============
+
+/*
+ * node_new() - Allocate an empty node.
+ */
+static struct btree_node *node_new(bool leaf)
+{
+	struct btree_node *x = calloc(1, sizeof(*x));
+
+	x->leaf = leaf;
+	return x;
+}
+
+/*
+ * lower_bound() - Return the index of the first item in x whose key is
+ * not less than key, or x->n if there is none.
+ */
+static int lower_bound(const table *t, const struct btree_node *x,
+		       const void *key)
+{
+	int lo = 0;
+	int hi = x->n;
+
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+		if (t->key_cmp_func(x->items[mid].key, key) < 0) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+/*
+ * find_item() - Return the item holding key, or NULL if the key is not
+ * found.
+ */
+static struct table_item *find_item(const table *t, const void *key)
+{
+	struct btree_node *x = t->root;
+
+	for (;;) {
+		int i = lower_bound(t, x, key);
+		if (i < x->n && t->key_cmp_func(x->items[i].key, key) == 0) {
+			return &x->items[i];
+		}
+		if (x->leaf) {
+			return NULL;
+		}
+		x = x->child[i];
+	}
+}
+
+/*
+ * split_child() - Split the full child i of x in two, moving its
+ * middle item up into x. x must not be full.
+ */
+static void split_child(struct btree_node *x, int i)
+{
+	struct btree_node *y = x->child[i];
+	struct btree_node *z = node_new(y->leaf);
+
+	// The upper MIN_DEGREE - 1 items and their children go to z.
+	z->n = MIN_DEGREE - 1;
+	for (int j = 0; j < MIN_DEGREE - 1; j++) {
+		z->items[j] = y->items[j + MIN_DEGREE];
+	}
+	if (!y->leaf) {
+		for (int j = 0; j < MIN_DEGREE; j++) {
+			z->child[j] = y->child[j + MIN_DEGREE];
+		}
+	}
+	y->n = MIN_DEGREE - 1;
+
+	// Make room in x for the middle item and z.
+	for (int j = x->n; j > i; j--) {
+		x->child[j + 1] = x->child[j];
+		x->items[j] = x->items[j - 1];
+	}
+	x->child[i + 1] = z;
+	x->items[i] = y->items[MIN_DEGREE - 1];
+	x->n++;
+}
+
+/*
+ * insert_nonfull() - Insert a new key below the non-full node x.
+ */
+static void insert_nonfull(const table *t, struct btree_node *x,
+			   struct table_item item)
+{
+	for (;;) {
+		int i = lower_bound(t, x, item.key);
+		if (x->leaf) {
+			for (int j = x->n; j > i; j--) {
+				x->items[j] = x->items[j - 1];
+			}
+			x->items[i] = item;
+			x->n++;
+			return;
+		}
+		// Split a full child on the way down, so there is always
+		// room for the item moved up by a split below.
+		if (x->child[i]->n == MAX_ITEMS) {
+			split_child(x, i);
+			if (t->key_cmp_func(x->items[i].key, item.key) < 0) {
+				i++;
+			}
+		}
+		x = x->child[i];
+	}
+}
+
+/*
+ * merge_children() - Merge child i + 1 of x and the item between them
+ * into child i. Both children must hold MIN_DEGREE - 1 items.
+ */
+static void merge_children(struct btree_node *x, int i)
+{
+	struct btree_node *y = x->child[i];
+	struct btree_node *z = x->child[i + 1];
+
+	y->items[y->n] = x->items[i];
+	for (int j = 0; j < z->n; j++) {
+		y->items[y->n + 1 + j] = z->items[j];
+	}
+	if (!y->leaf) {
+		for (int j = 0; j <= z->n; j++) {
+			y->child[y->n + 1 + j] = z->child[j];
+		}
+	}
+	y->n += z->n + 1;
+
+	for (int j = i; j < x->n - 1; j++) {
+		x->items[j] = x->items[j + 1];
+		x->child[j + 1] = x->child[j + 2];
+	}
+	x->n--;
+	free(z);
+}
+
+/*
+ * fill_child() - Make sure child i of x holds at least MIN_DEGREE
+ * items, by borrowing from a sibling or merging with one.
+ *
+ * Returns: The index of the child now covering the keys of child i.
+ */
+static int fill_child(struct btree_node *x, int i)
+{
+	struct btree_node *c = x->child[i];
+
+	if (c->n >= MIN_DEGREE) {
+		return i;
+	}
+	if (i > 0 && x->child[i - 1]->n >= MIN_DEGREE) {
+		// Rotate the last item of the left sibling in through x.
+		struct btree_node *s = x->child[i - 1];
+		for (int j = c->n; j > 0; j--) {
+			c->items[j] = c->items[j - 1];
+		}
+		if (!c->leaf) {
+			for (int j = c->n + 1; j > 0; j--) {
+				c->child[j] = c->child[j - 1];
+			}
+			c->child[0] = s->child[s->n];
+		}
+		c->items[0] = x->items[i - 1];
+		x->items[i - 1] = s->items[s->n - 1];
+		c->n++;
+		s->n--;
+		return i;
+	}
+	if (i < x->n && x->child[i + 1]->n >= MIN_DEGREE) {
+		// Rotate the first item of the right sibling in through x.
+		struct btree_node *s = x->child[i + 1];
+		c->items[c->n] = x->items[i];
+		if (!c->leaf) {
+			c->child[c->n + 1] = s->child[0];
+		}
+		x->items[i] = s->items[0];
+		for (int j = 0; j < s->n - 1; j++) {
+			s->items[j] = s->items[j + 1];
+		}
+		if (!s->leaf) {
+			for (int j = 0; j < s->n; j++) {
+				s->child[j] = s->child[j + 1];
+			}
+		}
+		c->n++;
+		s->n--;
+		return i;
+	}
+	if (i < x->n) {
+		merge_children(x, i);
+		return i;
+	}
+	merge_children(x, i - 1);
+	return i - 1;
+}
+
+/*
+ * delete_key() - Remove the item holding key from the subtree x. The
+ * item is only unlinked, its key and values are not freed.
+ *
+ * Every node entered on the way down holds at least MIN_DEGREE items
+ * (or is the root), so removing one item never underfills a node.
+ */
+static void delete_key(const table *t, struct btree_node *x,
+		       const void *key)
+{
+	for (;;) {
+		int i = lower_bound(t, x, key);
+		bool found = i < x->n
+			&& t->key_cmp_func(x->items[i].key, key) == 0;
+
+		if (found && x->leaf) {
+			for (int j = i; j < x->n - 1; j++) {
+				x->items[j] = x->items[j + 1];
+			}
+			x->n--;
+			return;
+		}
+		if (x->leaf) {
+			return;
+		}
+		if (found) {
+			struct btree_node *y = x->child[i];
+			struct btree_node *z = x->child[i + 1];
+			if (y->n >= MIN_DEGREE || z->n >= MIN_DEGREE) {
+				// Replace the item by its predecessor or
+				// successor and remove that one below.
+				struct btree_node *c = y->n >= MIN_DEGREE ? y : z;
+				struct btree_node *leaf = c;
+				struct table_item next;
+				if (c == y) {
+					while (!leaf->leaf) {
+						leaf = leaf->child[leaf->n];
+					}
+					next = leaf->items[leaf->n - 1];
+				} else {
+					while (!leaf->leaf) {
+						leaf = leaf->child[0];
+					}
+					next = leaf->items[0];
+				}
+				x->items[i] = next;
+				x = c;
+				key = next.key;
+				continue;
+			}
+			// Both neighbours are minimal. Merge them around
+			// the item and remove it from the merged node.
+			merge_children(x, i);
+			x = y;
+			continue;
+		}
+		x = x->child[fill_child(x, i)];
+	}
+}
+
+/*
+ * free_item() - Free the key and values of an item and its duplicates,
+ * if given the responsibility.
+ */
+static void free_item(const table *t, struct table_item *item)
+{
+	struct table_dup *d = item->older;
+
+	if (t->key_free_func != NULL) {
+		t->key_free_func(item->key);
+	}
+	if (t->value_free_func != NULL) {
+		t->value_free_func(item->value);
+	}
+	while (d != NULL) {
+		struct table_dup *next = d->next;
+		if (t->key_free_func != NULL) {
+			t->key_free_func(d->key);
+		}
+		if (t->value_free_func != NULL) {
+			t->value_free_func(d->value);
+		}
+		free(d);
+		d = next;
+	}
+}
+
+/*
+ * kill_node() - Free the subtree x and all its items.
+ */
+static void kill_node(const table *t, struct btree_node *x)
+{
+	for (int i = 0; i < x->n; i++) {
+		free_item(t, &x->items[i]);
+	}
+	if (!x->leaf) {
+		for (int i = 0; i <= x->n; i++) {
+			kill_node(t, x->child[i]);
+		}
+	}
+	free(x);
+}
+
+/*
+ * print_node() - Print the subtree x in key order.
+ */
+static void print_node(const struct btree_node *x,
+		       inspect_callback_pair print_func)
+{
+	for (int i = 0; i <= x->n; i++) {
+		if (!x->leaf) {
+			print_node(x->child[i], print_func);
+		}
+		if (i < x->n) {
+			const struct table_item *item = &x->items[i];
+			print_func(item->key, item->value);
+			for (struct table_dup *d = item->older; d != NULL;
+			     d = d->next) {
+				print_func(d->key, d->value);
+			}
+		}
+	}
+}
+
+/*
+ * range_node() - Visit the items of the subtree x with lo <= key <= hi
+ * in key order.
+ *
+ * Returns: False if a key above hi was met, so the caller can stop.
+ */
+static bool range_node(const table *t, const struct btree_node *x,
+		       const void *lo, const void *hi,
+		       inspect_callback_pair callback)
+{
+	// Children before the lower bound hold only smaller keys.
+	for (int i = lower_bound(t, x, lo); i <= x->n; i++) {
+		if (!x->leaf && !range_node(t, x->child[i], lo, hi, callback)) {
+			return false;
+		}
+		if (i < x->n) {
+			if (t->key_cmp_func(x->items[i].key, hi) > 0) {
+				return false;
+			}
+			callback(x->items[i].key, x->items[i].value);
+		}
+	}
+	return true;
+}
+
+/*
+ * sort_pairs() - Sort the pair indices idx[0..n) by key, keeping equal
+ * keys in index order. tmp must have room for n indices.
+ *
+ * Returns: The array, idx or tmp, holding the sorted indices.
+ */
+static int *sort_pairs(const table *t, void **keys, int *idx, int *tmp,
+		       int n)
+{
+	// Bottom-up merge sort, merging runs of width w from idx to tmp.
+	for (int w = 1; w < n; w *= 2) {
+		for (int lo = 0; lo < n; lo += 2 * w) {
+			int mid = lo + w < n ? lo + w : n;
+			int hi = lo + 2 * w < n ? lo + 2 * w : n;
+			int a = lo;
+			int b = mid;
+			int k = lo;
+			while (a < mid && b < hi) {
+				// Take from the left run on ties.
+				if (t->key_cmp_func(keys[idx[b]],
+						    keys[idx[a]]) < 0) {
+					tmp[k++] = idx[b++];
+				} else {
+					tmp[k++] = idx[a++];
+				}
+			}
+			while (a < mid) {
+				tmp[k++] = idx[a++];
+			}
+			while (b < hi) {
+				tmp[k++] = idx[b++];
+			}
+		}
+		int *swap = idx;
+		idx = tmp;
+		tmp = swap;
+	}
+	return idx;
+}
+
+/*
+ * bulk_load() - Build a tree from m items sorted by distinct keys.
+ *
+ * The items are cut into as few leaves as possible, with the item
+ * between two neighbouring leaves moved up as their separator. The
+ * nodes are then put under as few parents as possible, the separators
+ * between parents moving up again, until one node is left. Items and
+ * children are spread evenly, which leaves every node but the root at
+ * least half full.
+ */
+static struct btree_node *bulk_load(const struct table_item *items, int m)
+{
+	if (m <= MAX_ITEMS) {
+		struct btree_node *x = node_new(true);
+		for (int i = 0; i < m; i++) {
+			x->items[i] = items[i];
+		}
+		x->n = m;
+		return x;
+	}
+
+	// Number of leaves, and of items in them.
+	int k = (m + 1 + MAX_ITEMS) / (MAX_ITEMS + 1);
+	int in_leaves = m - (k - 1);
+	struct btree_node **nodes = malloc(k * sizeof(*nodes));
+	struct table_item *seps = malloc((k - 1) * sizeof(*seps));
+	int pos = 0;
+
+	for (int j = 0; j < k; j++) {
+		struct btree_node *x = node_new(true);
+		x->n = in_leaves / k + (j < in_leaves % k);
+		for (int i = 0; i < x->n; i++) {
+			x->items[i] = items[pos++];
+		}
+		if (j < k - 1) {
+			seps[j] = items[pos++];
+		}
+		nodes[j] = x;
+	}
+	// Each level is written over the start of the one below it.
+	while (k > 1) {
+		int parents = (k + MAX_ITEMS) / (MAX_ITEMS + 1);
+		pos = 0;
+		for (int j = 0; j < parents; j++) {
+			struct btree_node *x = node_new(false);
+			int c = k / parents + (j < k % parents);
+			for (int i = 0; i < c; i++) {
+				x->child[i] = nodes[pos + i];
+				if (i < c - 1) {
+					x->items[i] = seps[pos + i];
+				}
+			}
+			x->n = c - 1;
+			if (j < parents - 1) {
+				seps[j] = seps[pos + c - 1];
+			}
+			nodes[j] = x;
+			pos += c;
+		}
+		k = parents;
+	}
+
+	struct btree_node *root = nodes[0];
+	free(nodes);
+	free(seps);
+	return root;
+}
+
+/*
+ * iter_push_left() - Push x and the leftmost path below it onto the
+ * position stack of an iterator.
+ */
+static void iter_push_left(table_iter *it, struct btree_node *x)
+{
+	for (;;) {
+		it->pos[it->depth] = x;
+		it->idx[it->depth] = 0;
+		it->depth++;
+		if (x->leaf) {
+			return;
+		}
+		x = x->child[0];
+	}
+}
+
+// ===========EXTERNAL FUNCTION IMPLEMENTATIONS============
+
+/**
+ * table_empty() - Create an empty table.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_free_func: A pointer to a function (or NULL) to be called to
+ *		   de-allocate memory for keys on remove/kill.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
+ *
+ * The keys are kept ordered by key_cmp_func.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty(compare_function *key_cmp_func,
+		   free_function key_free_func,
+		   free_function value_free_func)
+{
+	// Allocate the table header.
+	table *t = calloc(1, sizeof(table));
+	// Store the key compare function and key/value free functions.
+	t->key_cmp_func = key_cmp_func;
+	t->key_free_func = key_free_func;
+	t->value_free_func = value_free_func;
+	// Start with an empty leaf as root.
+	t->root = node_new(true);
+
+	return t;
+}
+
+/**
+ * table_empty_hashed() - Create an empty table that hashes its keys.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_hash_func: Ignored. The keys are ordered, not hashed.
+ * @key_free_func: A pointer to a function (or NULL) to be called to
+ *		   de-allocate memory for keys on remove/kill.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_empty_hashed(compare_function *key_cmp_func,
+			  hash_function *key_hash_func,
+			  free_function key_free_func,
+			  free_function value_free_func)
+{
+	(void)key_hash_func;
+	return table_empty(key_cmp_func, key_free_func, value_free_func);
+}
+
+/**
+ * table_from_arrays() - Create a table holding n key/value pairs.
+ * @keys: Array of n key pointers.
+ * @values: Array of n value pointers.
+ * @n: Number of pairs.
+ * @key_cmp_func: A pointer to a function to be used to compare keys.
+ * @key_hash_func: Ignored. The keys are ordered, not hashed.
+ * @key_free_func: A pointer to a function (or NULL) to be called to
+ *		   de-allocate memory for keys on remove/kill.
+ * @value_free_func: A pointer to a function (or NULL) to be called to
+ *		     de-allocate memory for values on remove/kill.
+ *
+ * Same as inserting the pairs in array order. The pairs are sorted
+ * once and the tree is built bottom-up from the sorted keys, in
+ * O(n log n) compares but without searching the tree for each key.
+ *
+ * Returns: Pointer to a new table.
+ */
+table *table_from_arrays(void **keys, void **values, int n,
+			 compare_function *key_cmp_func,
+			 hash_function *key_hash_func,
+			 free_function key_free_func,
+			 free_function value_free_func)
+{
+	(void)key_hash_func;
+	table *t = table_empty(key_cmp_func, key_free_func, value_free_func);
+
+	if (n <= 0) {
+		return t;
+	}
+	int *idx = malloc(n * sizeof(*idx));
+	int *tmp = malloc(n * sizeof(*tmp));
+	struct table_item *items = malloc(n * sizeof(*items));
+	int m = 0;
+
+	for (int i = 0; i < n; i++) {
+		idx[i] = i;
+	}
+	int *sorted = sort_pairs(t, keys, idx, tmp, n);
+
+	// Make one item per run of equal keys. The sort keeps each run in
+	// array order, so its last pair is the latest and the others are
+	// pushed onto its list of older duplicates, oldest first.
+	for (int j = 0; j < n; ) {
+		int end = j + 1;
+		while (end < n && key_cmp_func(keys[sorted[end]],
+					       keys[sorted[j]]) == 0) {
+			end++;
+		}
+		struct table_item *item = &items[m++];
+		item->key = keys[sorted[end - 1]];
+		item->value = values[sorted[end - 1]];
+		item->older = NULL;
+		for (int q = j; q < end - 1; q++) {
+			struct table_dup *d = malloc(sizeof(*d));
+			d->key = keys[sorted[q]];
+			d->value = values[sorted[q]];
+			d->next = item->older;
+			item->older = d;
+		}
+		j = end;
+	}
+
+	free(t->root);
+	t->root = bulk_load(items, m);
+
+	free(idx);
+	free(tmp);
+	free(items);
+	return t;
+}
+
+/**
+ * table_is_empty() - Check if a table is empty.
+ * @table: Table to check.
+ *
+ * Returns: True if table contains no key/value pairs, false otherwise.
+ */
+bool table_is_empty(const table *t)
+{
+	return t->root->n == 0;
+}
+
+/**
+ * table_insert() - Add a key/value pair to a table.
+ * @table: Table to manipulate.
+ * @key: A pointer to the key.
+ * @value: A pointer to the value.
+ *
+ * Insert the key/value pair into the table. No test is performed to
+ * check if key is a duplicate. table_lookup() will return the latest
+ * added value for a duplicate key. table_remove() will remove all
+ * duplicates for a given key.
+ *
+ * Returns: Nothing.
+ */
+void table_insert(table *t, void *key, void *value)
+{
+	struct table_item *item = find_item(t, key);
+
+	if (item != NULL) {
+		// Duplicate key. Push the current pair onto the list of
+		// older ones and let the new pair take its place.
+		struct table_dup *d = malloc(sizeof(*d));
+		d->key = item->key;
+		d->value = item->value;
+		d->next = item->older;
+		item->older = d;
+		item->key = key;
+		item->value = value;
+		return;
+	}
+
+	struct table_item new_item = { key, value, NULL };
+	if (t->root->n == MAX_ITEMS) {
+		// Grow the tree by one level.
+		struct btree_node *r = node_new(false);
+		r->child[0] = t->root;
+		t->root = r;
+		split_child(r, 0);
+	}
+	insert_nonfull(t, t->root, new_item);
+}
+
+/**
+ * table_lookup() - Look up a given key in a table.
+ * @table: Table to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: The value corresponding to a given key, or NULL if the key
+ * is not found in the table. If the table contains duplicate keys,
+ * the value that was latest inserted will be returned.
+ */
+void *table_lookup(const table *t, const void *key)
+{
+	struct table_item *item = find_item(t, key);
+
+	return item != NULL ? item->value : NULL;
+}
+
+/**
+ * table_choose_key() - Return an arbitrary key.
+ * @t: Table to inspect.
+ *
+ * Return an arbitrary key stored in the table. Can be used together
+ * with table_remove() to deconstruct the table. Undefined for an
+ * empty table.
+ *
+ * Returns: An arbitrary key stored in the table.
+ */
+void *table_choose_key(const table *t)
+{
+	// The root is never empty in a non-empty table.
+	return t->root->items[0].key;
+}
+
+/**
+ * table_remove() - Remove a key/value pair in the table.
+ * @table: Table to manipulate.
+ * @key: Key for which to remove pair.
+ *
+ * Any matching duplicates will be removed. Will call any free
+ * functions set for keys/values. Does nothing if key is not found in
+ * the table.
+ *
+ * Returns: Nothing.
+ */
+void table_remove(table *t, const void *key)
+{
+	struct table_item *found = find_item(t, key);
+
+	if (found == NULL) {
+		return;
+	}
+	// Copy the item before unlinking it, since the removal moves
+	// items around. Its key may be the same memory as the given key,
+	// so free it only when the tree no longer needs to compare with
+	// the given key.
+	struct table_item item = *found;
+
+	delete_key(t, t->root, key);
+	if (t->root->n == 0 && !t->root->leaf) {
+		// The root lost its last item. Shrink the tree by one level.
+		struct btree_node *r = t->root;
+		t->root = r->child[0];
+		free(r);
+	}
+	free_item(t, &item);
+}
+
+/*
+ * table_kill() - Destroy a table.
+ * @table: Table to destroy.
+ *
+ * Return all dynamic memory used by the table and its elements. If a
+ * free_func was registered for keys and/or values at table creation,
+ * it is called each element to free any user-allocated memory
+ * occupied by the element keys and values.
+ *
+ * Returns: Nothing.
+ */
+void table_kill(table *t)
+{
+	// Destroy all nodes and elements...
+	kill_node(t, t->root);
+	// ...and the table.
+	free(t);
+}
+
+/**
+ * table_print() - Print the given table.
+ * @t: Table to print.
+ * @print_func: Function called for each key/value pair in the table.
+ *
+ * Iterates over the key/value pairs in the table in key order and
+ * prints them. Will print all stored elements, including duplicates.
+ *
+ * Returns: Nothing.
+ */
+void table_print(const table *t, inspect_callback_pair print_func)
+{
+	print_node(t->root, print_func);
+}
+
+/**
+ * table_min() - Return the smallest key in a table.
+ * @t: Table to inspect.
+ *
+ * Returns: The smallest key stored in the table, or NULL if the table
+ * is empty.
+ */
+void *table_min(const table *t)
+{
+	const struct btree_node *x = t->root;
+
+	if (x->n == 0) {
+		return NULL;
+	}
+	while (!x->leaf) {
+		x = x->child[0];
+	}
+	return x->items[0].key;
+}
+
+/**
+ * table_max() - Return the largest key in a table.
+ * @t: Table to inspect.
+ *
+ * Returns: The largest key stored in the table, or NULL if the table
+ * is empty.
+ */
+void *table_max(const table *t)
+{
+	const struct btree_node *x = t->root;
+
+	if (x->n == 0) {
+		return NULL;
+	}
+	while (!x->leaf) {
+		x = x->child[x->n];
+	}
+	return x->items[x->n - 1].key;
+}
+
+/**
+ * table_floor() - Find the largest key not greater than a given key.
+ * @t: Table to inspect.
+ * @key: Key to search for.
+ *
+ * Returns: The largest stored key that compares less than or equal to
+ * key, or NULL if there is none.
+ */
+void *table_floor(const table *t, const void *key)
+{
+	const struct btree_node *x = t->root;
+	void *best = NULL;
+
+	for (;;) {
+		int i = lower_bound(t, x, key);
+		if (i < x->n && t->key_cmp_func(x->items[i].key, key) == 0) {
+			return x->items[i].key;
+		}
+		// Keys further down are larger than items[i - 1].
+		if (i > 0) {
+			best = x->items[i - 1].key;
+		}
+		if (x->leaf) {
+			return best;
+		}
+		x = x->child[i];
+	}
+}
+
+/**
+ * table_ceiling() - Find the smallest key not less than a given key.
+ * @t: Table to inspect.
+ * @key: Key to search for.
+ *
+ * Returns: The smallest stored key that compares greater than or
+ * equal to key, or NULL if there is none.
+ */
+void *table_ceiling(const table *t, const void *key)
+{
+	const struct btree_node *x = t->root;
+	void *best = NULL;
+
+	for (;;) {
+		int i = lower_bound(t, x, key);
+		if (i < x->n) {
+			if (t->key_cmp_func(x->items[i].key, key) == 0) {
+				return x->items[i].key;
+			}
+			// Keys further down are smaller than items[i].
+			best = x->items[i].key;
+		}
+		if (x->leaf) {
+			return best;
+		}
+		x = x->child[i];
+	}
+}
+
+/**
+ * table_range() - Visit all key/value pairs in a key range.
+ * @t: Table to inspect.
+ * @lo: Smallest key to visit.
+ * @hi: Largest key to visit.
+ * @callback: Function called for each key/value pair with lo <= key
+ *	      <= hi, in increasing key order.
+ *
+ * Only the latest value of a duplicate key is visited. Takes time
+ * proportional to log n plus the number of pairs visited.
+ *
+ * Returns: Nothing.
+ */
+void table_range(const table *t, const void *lo, const void *hi,
+		 inspect_callback_pair callback)
+{
+	range_node(t, t->root, lo, hi, callback);
+}
+
+/**
+ * table_iter_begin() - Start iterating over the pairs of a table.
+ * @t: Table to inspect.
+ * @it: Iterator to set up.
+ *
+ * Visits the pairs in increasing key order, each key followed by its
+ * older duplicates. Any insert or remove invalidates the iterator.
+ *
+ * Returns: Nothing.
+ */
+void table_iter_begin(const table *t, table_iter *it)
+{
+	it->t = t;
+	it->depth = 0;
+	it->next = NULL;
+	iter_push_left(it, t->root);
+}
+
+/**
+ * table_iter_next() - Advance an iterator to the next pair.
+ * @it: Iterator to advance.
+ * @key: Set to the key of the pair.
+ * @value: Set to the value of the pair.
+ *
+ * Returns: True if a pair was found, false when all pairs have been
+ * visited.
+ */
+bool table_iter_next(table_iter *it, void **key, void **value)
+{
+	// Older duplicates of the last visited item come first.
+	if (it->next != NULL) {
+		struct table_dup *d = it->next;
+		*key = d->key;
+		*value = d->value;
+		it->next = d->next;
+		return true;
+	}
+	while (it->depth > 0) {
+		struct btree_node *x = it->pos[it->depth - 1];
+		size_t i = it->idx[it->depth - 1];
+		if (i == (size_t)x->n) {
+			// All items of the node visited.
+			it->depth--;
+			continue;
+		}
+		it->idx[it->depth - 1]++;
+		if (!x->leaf) {
+			iter_push_left(it, x->child[i + 1]);
+		}
+		*key = x->items[i].key;
+		*value = x->items[i].value;
+		it->next = x->items[i].older;
+		return true;
+	}
+	return false;
+}
+
+/**
+ * table_drain() - Remove one pair from a table and hand it over.
+ * @t: Table to manipulate.
+ * @key: Set to the key of the removed pair.
+ * @value: Set to the value of the removed pair.
+ *
+ * Removes the pair with the smallest key, an older duplicate before
+ * the latest one. The free functions are not called: the caller takes
+ * over the key and value. Takes O(log n) time.
+ *
+ * Returns: True if a pair was removed, false if the table was empty.
+ */
+bool table_drain(table *t, void **key, void **value)
+{
+	struct btree_node *x = t->root;
+
+	if (x->n == 0) {
+		return false;
+	}
+	while (!x->leaf) {
+		x = x->child[0];
+	}
+	struct table_item *item = &x->items[0];
+	if (item->older != NULL) {
+		// Hand over the newest older duplicate.
+		struct table_dup *d = item->older;
+		*key = d->key;
+		*value = d->value;
+		item->older = d->next;
+		free(d);
+		return true;
+	}
+	*key = item->key;
+	*value = item->value;
+	delete_key(t, t->root, *key);
+	if (t->root->n == 0 && !t->root->leaf) {
+		// The root lost its last item. Shrink the tree by one level.
+		struct btree_node *r = t->root;
+		t->root = r->child[0];
+		free(r);
+	}
+	return true;
+}
@@ -5,9 +5,9 @@
 #include "table.h"
 
 /*
- * Minimum working example for table.c. Inserts 4 key-key pairs into
+ * Minimum working example for table.c. Inserts 4 key-value pairs into
  * a table, including one duplicate. Makes two lookups and prints the
- * result. The responsibility to deallocate the key-key pairs is NOT
+ * result. The responsibility to deallocate the key-value pairs is NOT
  * handed over to the table. Thus, all pointers must be stored outside
  * the table.
  *
@@ -27,11 +27,11 @@ static char* make_string_copy(const char *str)
 	return copy;
 }
 
-// Interpret the supplied key and key pointers and print their content.
-static void print_int_string_pair(const void *key, const void *key)
+// Interpret the supplied key and value pointers and print their content.
+static void print_int_string_pair(const void *key, const void *value)
 {
 	const int *k=key;
-	const char *s=key;
+	const char *s=value;
 	printf("[%d, %s]\n", *k, s);
 }
 
@@ -50,26 +50,26 @@ static int compare_ints(const void *k1, const void *k2)
 
 int main(void)
 {
-	// Keep track of the key-key pairs we allocate.
+	// Keep track of the key-value pairs we allocate.
 	int *key[4];
-	char *key[4];
+	char *value[4];
 
 	table *t = table_empty(compare_ints, NULL, NULL);
 
 	key[0] = malloc(sizeof(int));
 	*key[0] = 90187;
-	key[0] = make_string_copy("Umea");
-	table_insert(t, key[0], key[0]);
+	value[0] = make_string_copy("Umea");
+	table_insert(t, key[0], value[0]);
 
 	key[1] = malloc(sizeof(int));
 	*key[1] = 90184;
-	key[1] = make_string_copy("Umea");
-	table_insert(t, key[1], key[1]);
+	value[1] = make_string_copy("Umea");
+	table_insert(t, key[1], value[1]);
 
 	key[2] = malloc(sizeof(int));
 	*key[2] = 98185;
-	key[2] = make_string_copy("Kiruna");
-	table_insert(t, key[2], key[2]);
+	value[2] = make_string_copy("Kiruna");
+	table_insert(t, key[2], value[2]);
 
 	printf("Table after inserting 3 pairs:\n");
 	table_print(t, print_int_string_pair);
@@ -80,8 +80,8 @@ int main(void)
 
 	key[3] = malloc(sizeof(int));
 	*key[3] = 90187;
-	key[3] = make_string_copy("Umea (Universitet)");
-	table_insert(t, key[3], key[3]);
+	value[3] = make_string_copy("Umea (Universitet)");
+	table_insert(t, key[3], value[3]);
 
 	printf("Table after adding a duplicate:\n");
 	table_print(t, print_int_string_pair);
@@ -96,6 +96,6 @@ int main(void)
         // Free key/key pairs that we put in the table.
         for (int i=0; i<sizeof(key)/sizeof(key[0]); i++) {
                 free(key[i]);
-                free(key[i]);
+                free(value[i]);
         }
 }
@@ -5,10 +5,10 @@
 #include "table.h"
 
 /*
- * Minimum working example for table.c. Inserts 4 key-key pairs into
+ * Minimum working example for table.c. Inserts 4 key-value pairs into
  * a table, including one duplicate. Makes two lookups and prints the
- * result. The responsibility to deallocate the key-key pairs IS
- * handed over to the table. Thus, no key-key pointers need to be
+ * result. The responsibility to deallocate the key-value pairs IS
+ * handed over to the table. Thus, no key-value pointers need to be
  * stored outside the table.
  *
  * Authors: Niclas Borlin (niclas@cs.umu.se)
@@ -27,11 +27,11 @@ static char* make_string_copy(const char *str)
 	return copy;
 }
 
-// Interpret the supplied key and key pointers and print their content.
-static void print_int_string_pair(const void *key, const void *key)
+// Interpret the supplied key and value pointers and print their content.
+static void print_int_string_pair(const void *key, const void *value)
 {
 	const int *k=key;
-	const char *s=key;
+	const char *s=value;
 	printf("[%d, %s]\n", *k, s);
 }
 
@@ -57,37 +57,37 @@ void free_key_ptr(void *p)
 	free(key);
 }
 
-// Free a key pointer.
-void free_key_ptr(void *p)
+// Free a value pointer.
+void free_value_ptr(void *p)
 {
 	// Convert the incoming void * to a char * purely to be able
 	// to debug the deallocation.
-	char *key=p;
-	free(key);
+	char *value=p;
+	free(value);
 }
 
 int main(void)
 {
 	// Delegate the deallocation responsibility to the table.
-	table *t = table_empty(compare_ints, free_key_ptr, free_key_ptr);
+	table *t = table_empty(compare_ints, free_key_ptr, free_value_ptr);
 
 	int *key;
-	char *key;
+	char *value;
 
 	key = malloc(sizeof(int));
 	*key = 90187;
-	key = make_string_copy("Umea");
-	table_insert(t, key, key);
+	value = make_string_copy("Umea");
+	table_insert(t, key, value);
 
 	key = malloc(sizeof(int));
 	*key = 90184;
-	key = make_string_copy("Umea");
-	table_insert(t, key, key);
+	value = make_string_copy("Umea");
+	table_insert(t, key, value);
 
 	key = malloc(sizeof(int));
 	*key = 98185;
-	key = make_string_copy("Kiruna");
-	table_insert(t, key, key);
+	value = make_string_copy("Kiruna");
+	table_insert(t, key, value);
 
 	printf("Table after inserting 3 pairs:\n");
 	table_print(t, print_int_string_pair);
@@ -98,8 +98,8 @@ int main(void)
 
 	key = malloc(sizeof(int));
 	*key = 90187;
-	key = make_string_copy("Umea (Universitet)");
-	table_insert(t, key, key);
+	value = make_string_copy("Umea (Universitet)");
+	table_insert(t, key, value);
 
 	printf("Table after adding a duplicate:\n");
 	table_print(t, print_int_string_pair);
@@ -5,10 +5,10 @@
 #include "table.h"
 
 /*
- * Minimum working example for table.c. Inserts 3 key-key pairs into
+ * Minimum working example for table.c. Inserts 3 key-value pairs into
  * a table, no duplicates. Makes one lookup and prints the result. The
- * responsibility to deallocate the key-key pairs is NOT handed over
- * to the table. Use table_choose_key() to extract keys and keys to
+ * responsibility to deallocate the key-value pairs is NOT handed over
+ * to the table. Use table_choose_key() to extract keys and values to
  * be able to destroy the table without memory leaks or externally
  * stored pointers.
  *
@@ -27,11 +27,11 @@ static char* make_string_copy(const char *str)
 	return copy;
 }
 
-// Interpret the supplied key and key pointers and print their content.
-static void print_int_string_pair(const void *key, const void *key)
+// Interpret the supplied key and value pointers and print their content.
+static void print_int_string_pair(const void *key, const void *value)
 {
 	const int *k=key;
-	const char *s=key;
+	const char *s=value;
 	printf("[%d, %s]\n", *k, s);
 }
 
@@ -54,22 +54,22 @@ int main(void)
 	table *t = table_empty(compare_ints, NULL, NULL);
 
 	int *key;
-	char *key;
+	char *value;
 
 	key = malloc(sizeof(int));
 	*key = 90187;
-	key = make_string_copy("Umea");
-	table_insert(t, key, key);
+	value = make_string_copy("Umea");
+	table_insert(t, key, value);
 
 	key = malloc(sizeof(int));
 	*key = 90184;
-	key = make_string_copy("Umea");
-	table_insert(t, key, key);
+	value = make_string_copy("Umea");
+	table_insert(t, key, value);
 
 	key = malloc(sizeof(int));
 	*key = 98185;
-	key = make_string_copy("Kiruna");
-	table_insert(t, key, key);
+	value = make_string_copy("Kiruna");
+	table_insert(t, key, value);
 
 	printf("Table after inserting 3 pairs:\n");
 	table_print(t, print_int_string_pair);
@@ -82,13 +82,13 @@ int main(void)
 	while (!table_is_empty(t)) {
 		// Get one key from the table.
 		key=table_choose_key(t);
-		// Lookup the corresponding key.
-		key=table_lookup(t,key);
-		// Remove the key-key pair from the table.
+		// Lookup the corresponding value.
+		value=table_lookup(t,key);
+		// Remove the key-value pair from the table.
 		table_remove(t,key);
-		// De-allocate key and key.
-		free(key);
+		// De-allocate key and value.
 		free(key);
+		free(value);
 	}
 	// Kill what is left by the table.
 	table_kill(t);
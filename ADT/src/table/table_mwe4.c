@@ -0,0 +1,81 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "table.h"
+
+/*
+ * Minimum working example for table_empty_hashed(). Inserts n
+ * key-value pairs, with n given as argument (default 10000), then
+ * replaces every tenth value by inserting a duplicate key. Looks up
+ * all keys, removes the even ones, and prints what is left. The
+ * responsibility to deallocate the key-value pairs is handed over to
+ * the table. With table3.c each operation takes constant time, with
+ * table.c and table2.c it takes time proportional to the table size.
+ *
+ * Version information:
+ *   2026-10-17: v1.0, first public version.
+ */
+
+// Compare two keys (int *).
+static int compare_ints(const void *k1, const void *k2)
+{
+	int key1 = *(int *)k1;
+	int key2 = *(int *)k2;
+
+	if ( key1 == key2 )
+		return 0;
+	if ( key1 < key2 )
+		return -1;
+	return 1;
+}
+
+// Hash a key (int *). Equal keys give equal hashes.
+static unsigned long hash_int(const void *k)
+{
+	return (unsigned int)*(const int *)k;
+}
+
+// Create a dynamic int with the given value.
+static int *make_int(int v)
+{
+	int *p = malloc(sizeof(int));
+	*p = v;
+	return p;
+}
+
+int main(int argc, char *argv[])
+{
+	int n = argc > 1 ? atoi(argv[1]) : 10000;
+
+	// Delegate the deallocation responsibility to the table.
+	table *t = table_empty_hashed(compare_ints, hash_int, free, free);
+
+	for (int i = 0; i < n; i++) {
+		table_insert(t, make_int(i), make_int(i));
+	}
+	// Duplicates. Lookup will return the latest value.
+	for (int i = 0; i < n; i += 10) {
+		table_insert(t, make_int(i), make_int(-i));
+	}
+
+	long sum = 0;
+	for (int i = 0; i < n; i++) {
+		int *v = table_lookup(t, &i);
+		sum += *v;
+	}
+	printf("Sum of %d latest values: %ld.\n", n, sum);
+
+	// Remove the even keys, duplicates included.
+	for (int i = 0; i < n; i += 2) {
+		table_remove(t, &i);
+	}
+	int left = 0;
+	for (int i = 0; i < n; i++) {
+		left += table_lookup(t, &i) != NULL;
+	}
+	printf("Keys left after removing the even ones: %d.\n", left);
+
+	table_kill(t);
+	return 0;
+}
@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ordered_table.h"
+
+/*
+ * Minimum working example for the ordered table (table4.c). Inserts
+ * the even keys 0, 2, ..., 2(n - 1), with n given as argument (default
+ * 10000), and a duplicate of key 10. Prints the min, max, floor and
+ * ceiling of a few keys, sums a key range, then removes every fourth
+ * key and sums the range again. The responsibility to deallocate the
+ * key-value pairs is handed over to the table.
+ *
+ * Version information:
+ *   2026-10-17: v1.0, first public version.
+ */
+
+// Compare two keys (int *).
+static int compare_ints(const void *k1, const void *k2)
+{
+	int key1 = *(int *)k1;
+	int key2 = *(int *)k2;
+
+	if ( key1 == key2 )
+		return 0;
+	if ( key1 < key2 )
+		return -1;
+	return 1;
+}
+
+// Create a dynamic int with the given value.
+static int *make_int(int v)
+{
+	int *p = malloc(sizeof(int));
+	*p = v;
+	return p;
+}
+
+// Print a key (int *) or "none" for NULL.
+static void print_key(const char *name, int key, const int *found)
+{
+	if (found != NULL) {
+		printf("%s(%d) = %d\n", name, key, *found);
+	} else {
+		printf("%s(%d) = none\n", name, key);
+	}
+}
+
+// Sum of the values visited by table_range().
+static long range_sum;
+static int range_count;
+
+static void add_pair(const void *key, const void *value)
+{
+	(void)key;
+	range_sum += *(const int *)value;
+	range_count++;
+}
+
+int main(int argc, char *argv[])
+{
+	int n = argc > 1 ? atoi(argv[1]) : 10000;
+
+	// Delegate the deallocation responsibility to the table.
+	table *t = table_empty(compare_ints, free, free);
+
+	// Insert out of order: odd i descending, then even i ascending.
+	for (int i = n - 1; i >= 0; i--) {
+		if (i % 2 == 1) {
+			table_insert(t, make_int(2 * i), make_int(2 * i));
+		}
+	}
+	for (int i = 0; i < n; i += 2) {
+		table_insert(t, make_int(2 * i), make_int(2 * i));
+	}
+	// Duplicate. Queries see the latest value.
+	table_insert(t, make_int(10), make_int(-10));
+
+	printf("min = %d, max = %d\n", *(int *)table_min(t),
+	       *(int *)table_max(t));
+	int probes[] = { -1, 10, 11, 2 * n };
+	for (int i = 0; i < 4; i++) {
+		print_key("floor", probes[i], table_floor(t, &probes[i]));
+		print_key("ceiling", probes[i], table_ceiling(t, &probes[i]));
+	}
+
+	int lo = 5;
+	int hi = 25;
+	table_range(t, &lo, &hi, add_pair);
+	printf("Range [%d, %d]: %d keys, sum %ld.\n", lo, hi, range_count,
+	       range_sum);
+
+	// Remove every fourth key.
+	for (int k = 0; k < 2 * n; k += 8) {
+		table_remove(t, &k);
+	}
+	range_sum = 0;
+	range_count = 0;
+	table_range(t, &lo, &hi, add_pair);
+	printf("Range [%d, %d] after removal: %d keys, sum %ld.\n", lo, hi,
+	       range_count, range_sum);
+
+	table_kill(t);
+	return 0;
+}
@@ -0,0 +1,88 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "table.h"
+
+/*
+ * Minimum working example for table_from_arrays(). Builds a table from
+ * arrays of n key-value pairs, with n given as argument (default
+ * 10000), where every tenth key comes again at the end with a new
+ * value. Looks up all keys, then removes the even ones. The
+ * responsibility to deallocate the key-value pairs is handed over to
+ * the table.
+ *
+ * Version information:
+ *   2026-10-17: v1.0, first public version.
+ */
+
+// Compare two keys (int *).
+static int compare_ints(const void *k1, const void *k2)
+{
+	int key1 = *(int *)k1;
+	int key2 = *(int *)k2;
+
+	if ( key1 == key2 )
+		return 0;
+	if ( key1 < key2 )
+		return -1;
+	return 1;
+}
+
+// Hash a key (int *). Equal keys give equal hashes.
+static unsigned long hash_int(const void *k)
+{
+	return (unsigned int)*(const int *)k;
+}
+
+// Create a dynamic int with the given value.
+static int *make_int(int v)
+{
+	int *p = malloc(sizeof(int));
+	*p = v;
+	return p;
+}
+
+int main(int argc, char *argv[])
+{
+	int n = argc > 1 ? atoi(argv[1]) : 10000;
+	int dups = (n + 9) / 10;
+	void **keys = malloc((n + dups) * sizeof(*keys));
+	void **values = malloc((n + dups) * sizeof(*values));
+
+	// The keys in descending order, then the duplicates.
+	for (int i = 0; i < n; i++) {
+		keys[i] = make_int(n - 1 - i);
+		values[i] = make_int(n - 1 - i);
+	}
+	for (int j = 0; j < dups; j++) {
+		keys[n + j] = make_int(10 * j);
+		values[n + j] = make_int(-10 * j);
+	}
+
+	// Delegate the deallocation responsibility to the table. The
+	// arrays themselves are no longer needed.
+	table *t = table_from_arrays(keys, values, n + dups, compare_ints,
+				     hash_int, free, free);
+	free(keys);
+	free(values);
+
+	long sum = 0;
+	for (int i = 0; i < n; i++) {
+		int *v = table_lookup(t, &i);
+		sum += *v;
+	}
+	printf("Sum of %d latest values: %ld.\n", n, sum);
+
+	// Remove the even keys, duplicates included.
+	for (int i = 0; i < n; i += 2) {
+		table_remove(t, &i);
+	}
+	int left = 0;
+	for (int i = 0; i < n; i++) {
+		left += table_lookup(t, &i) != NULL;
+	}
+	printf("Keys left after removing the even ones: %d.\n", left);
+
+	table_kill(t);
+	return 0;
+}
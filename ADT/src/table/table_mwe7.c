@@ -0,0 +1,85 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "table.h"
+
+/*
+ * Minimum working example for table_iter and table_drain(). Inserts 3
+ * key-value pairs and a duplicate into a table, and walks the pairs
+ * with an iterator. The responsibility to deallocate the key-value
+ * pairs is NOT handed over to the table. Use table_drain() to take the
+ * pairs out of the table and destroy it without memory leaks, in time
+ * proportional to the table size.
+ *
+ * Version information:
+ *   2026-10-17: v1.0, first public version.
+ */
+
+// Create a dynamic copy of the string str.
+static char* make_string_copy(const char *str)
+{
+	char *copy = calloc(strlen(str) + 1, sizeof(char));
+	strcpy(copy, str);
+	return copy;
+}
+
+// Create a dynamic int with the given value.
+static int *make_int(int v)
+{
+	int *p = malloc(sizeof(int));
+	*p = v;
+	return p;
+}
+
+// Compare two keys (int *).
+static int compare_ints(const void *k1, const void *k2)
+{
+	int key1 = *(int *)k1;
+	int key2 = *(int *)k2;
+
+	if ( key1 == key2 )
+		return 0;
+	if ( key1 < key2 )
+		return -1;
+	return 1;
+}
+
+int main(void)
+{
+	// Keep the deallocation responsibility.
+	table *t = table_empty(compare_ints, NULL, NULL);
+
+	table_insert(t, make_int(90187), make_string_copy("Umea"));
+	table_insert(t, make_int(90184), make_string_copy("Umea"));
+	table_insert(t, make_int(98185), make_string_copy("Kiruna"));
+	table_insert(t, make_int(90187), make_string_copy("Umea (Universitet)"));
+
+	// Walk the pairs without a callback.
+	table_iter it;
+	void *key;
+	void *value;
+	int n = 0;
+
+	printf("Table after inserting 4 pairs:\n");
+	table_iter_begin(t, &it);
+	while (table_iter_next(&it, &key, &value)) {
+		printf("[%d, %s]\n", *(int *)key, (char *)value);
+		n++;
+	}
+	printf("Iterated over %d pairs.\n", n);
+
+	// Take out each pair, duplicates included, and de-allocate it.
+	n = 0;
+	while (table_drain(t, &key, &value)) {
+		free(key);
+		free(value);
+		n++;
+	}
+	printf("Drained %d pairs. Table empty: %s.\n", n,
+	       table_is_empty(t) ? "yes" : "no");
+
+	// Kill what is left by the table.
+	table_kill(t);
+	return 0;
+}
@@ -0,0 +1,132 @@
+#define _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include "hashtable.h"
+
+/*
+ * Measures throughput of the concurrent hashtable from one thread up
+ * to the number of online cores (or the count given as argument),
+ * against a plain hashtable behind one global mutex. Each thread
+ * runs OPS operations on random keys of a shared key set: 90% gets
+ * and 10% puts.
+ */
+
+#define KEYS 65536
+#define OPS 2000000
+#define KEYLEN 16
+
+static char keys[KEYS][KEYLEN];
+
+struct worker {
+    pthread_t thread;
+    uint64_t rng;
+    bool global_lock;
+    hashtable_concurrent *ctbl;
+    hashtable *tbl;
+    pthread_mutex_t *lock;
+    long hits;
+};
+
+static inline uint64_t next_rand(uint64_t *s) {
+    *s ^= *s << 13;
+    *s ^= *s >> 7;
+    *s ^= *s << 17;
+    return *s;
+}
+
+static void *run_worker(void *arg) {
+    struct worker *w = arg;
+
+    for (long op = 0; op < OPS; op++) {
+        uint64_t r = next_rand(&w->rng);
+        char *key = keys[r % KEYS];
+        bool write = (r >> 32) % 10 == 0;
+
+        if (w->global_lock) {
+            pthread_mutex_lock(w->lock);
+            if (write) {
+                hashtable_put(w->tbl, key, key);
+            } else {
+                w->hits += hashtable_get(w->tbl, key) != NULL;
+            }
+            pthread_mutex_unlock(w->lock);
+        } else if (write) {
+            hashtable_concurrent_put(w->ctbl, key, key);
+        } else {
+            w->hits += hashtable_concurrent_get(w->ctbl, key) != NULL;
+        }
+    }
+    return NULL;
+}
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Run n threads and return the total throughput in Mops/s.
+static double run(int n, bool global_lock, hashtable_concurrent *ctbl,
+                  hashtable *tbl, pthread_mutex_t *lock) {
+    struct worker *w = calloc(n, sizeof(*w));
+    double start = now();
+
+    for (int i = 0; i < n; i++) {
+        w[i].rng = 0x9e3779b97f4a7c15ULL * (i + 1);
+        w[i].global_lock = global_lock;
+        w[i].ctbl = ctbl;
+        w[i].tbl = tbl;
+        w[i].lock = lock;
+        pthread_create(&w[i].thread, NULL, run_worker, &w[i]);
+    }
+    for (int i = 0; i < n; i++) {
+        pthread_join(w[i].thread, NULL);
+    }
+    double secs = now() - start;
+    free(w);
+    return (double)n * OPS / secs / 1e6;
+}
+
+int main(int argc, char **argv) {
+    int max_threads = argc > 1 ? atoi(argv[1])
+                               : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (max_threads < 1) {
+        max_threads = 1;
+    }
+
+    hashtable_concurrent *ctbl = hashtable_concurrent_create(4 * max_threads,
+                                                             NULL);
+    hashtable *tbl = hashtable_empty(2 * KEYS);
+    pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+    for (int i = 0; i < KEYS; i++) {
+        snprintf(keys[i], KEYLEN, "key%d", i);
+        if (i % 2 == 0) {
+            hashtable_concurrent_put(ctbl, keys[i], keys[i]);
+            hashtable_put(tbl, keys[i], keys[i]);
+        }
+    }
+
+    printf("%7s %14s %9s %14s %9s\n", "threads", "sharded Mops/s", "speedup",
+           "global Mops/s", "speedup");
+    double base_c = 0, base_g = 0;
+    for (int n = 1; ; n = 2 * n < max_threads ? 2 * n : max_threads) {
+        double c = run(n, false, ctbl, tbl, &lock);
+        double g = run(n, true, ctbl, tbl, &lock);
+        if (n == 1) {
+            base_c = c;
+            base_g = g;
+        }
+        printf("%7d %14.2f %8.2fx %14.2f %8.2fx\n", n, c, c / base_c,
+               g, g / base_g);
+        if (n == max_threads) {
+            break;
+        }
+    }
+
+    hashtable_concurrent_kill(ctbl);
+    hashtable_kill(tbl);
+    return 0;
+}
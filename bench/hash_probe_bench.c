@@ -0,0 +1,152 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hashtable.h"
+
+/*
+ * Compares the probe-length distribution of the built-in seeded hash
+ * with the original character-sum hash. Each key set is placed in a
+ * simulated linear-probe table of SLOTS slots at several load factors.
+ * The probe length of a key is the number of slots inspected to place
+ * it, i.e. 1 if the home slot was free.
+ */
+
+#define SLOTS 65536
+#define KEYLEN 32
+
+// Histogram buckets: 1, 2, 3-4, 5-8, 9-16, 17-32, 33+.
+#define BUCKETS 7
+
+typedef int (*home_func)(hashtable *tbl, char *key);
+
+// The original hashtable_hash(): sum of the characters, max % sum.
+static int legacy_hash(hashtable *tbl, char *key) {
+    int asc_sum = 0;
+    for (size_t i = 0; i < strlen(key); i++) {
+        asc_sum += key[i];
+    }
+    return SLOTS % asc_sum;
+}
+
+static int bucket_of(int probes) {
+    int b = 0;
+    while (b < BUCKETS - 1 && probes > (1 << b)) {
+        b++;
+    }
+    return b;
+}
+
+// Insert n keys into a fresh simulated table and print the statistics.
+static void run(const char *set, const char *name, home_func home,
+                hashtable *tbl, char **keys, int n) {
+    char *used = calloc(SLOTS, 1);
+    int *probes = calloc(n, sizeof(*probes));
+    long hist[BUCKETS] = { 0 };
+    long total = 0;
+    int longest = 0;
+
+    for (int i = 0; i < n; i++) {
+        int idx = home(tbl, keys[i]);
+        int p = 1;
+        while (used[idx]) {
+            idx = (idx + 1) % SLOTS;
+            p++;
+        }
+        used[idx] = 1;
+        probes[i] = p;
+        total += p;
+        hist[bucket_of(p)]++;
+        if (p > longest) {
+            longest = p;
+        }
+    }
+
+    printf("%-10s %5.2f %-7s %8.2f %7d", set, (double)n / SLOTS, name,
+           (double)total / n, longest);
+    for (int b = 0; b < BUCKETS; b++) {
+        printf(" %6.1f%%", 100.0 * hist[b] / n);
+    }
+    printf("\n");
+
+    free(probes);
+    free(used);
+}
+
+// "key0", "key1", ...
+static void make_sequential(char **keys, int n) {
+    for (int i = 0; i < n; i++) {
+        snprintf(keys[i], KEYLEN, "key%d", i);
+    }
+}
+
+// Distinct permutations of one string: every key has the same sum.
+static void make_anagrams(char **keys, int n) {
+    char word[] = "abcdefghij";
+    int len = strlen(word);
+
+    for (int i = 0; i < n; i++) {
+        strcpy(keys[i], word);
+        // Step to the next permutation in lexicographic order.
+        int k = len - 2;
+        while (k >= 0 && word[k] >= word[k + 1]) {
+            k--;
+        }
+        int l = len - 1;
+        while (word[l] <= word[k]) {
+            l--;
+        }
+        char t = word[k];
+        word[k] = word[l];
+        word[l] = t;
+        for (int a = k + 1, b = len - 1; a < b; a++, b--) {
+            t = word[a];
+            word[a] = word[b];
+            word[b] = t;
+        }
+    }
+}
+
+// Random lower-case words of 4 to 16 characters.
+static void make_random(char **keys, int n) {
+    srand(4711);
+    for (int i = 0; i < n; i++) {
+        int len = 4 + rand() % 13;
+        for (int c = 0; c < len; c++) {
+            keys[i][c] = 'a' + rand() % 26;
+        }
+        keys[i][len] = '\0';
+    }
+}
+
+int main(void) {
+    const double loads[] = { 0.5, 0.75, 0.9 };
+    const char *sets[] = { "sequential", "anagram", "random" };
+    void (*makers[])(char **, int) = {
+        make_sequential, make_anagrams, make_random
+    };
+    int n_max = SLOTS;
+    char **keys = malloc(n_max * sizeof(*keys));
+    for (int i = 0; i < n_max; i++) {
+        keys[i] = malloc(KEYLEN);
+    }
+    hashtable *tbl = hashtable_empty(SLOTS);
+
+    printf("%-10s %5s %-7s %8s %7s %7s %7s %7s %7s %7s %7s %7s\n",
+           "keys", "load", "hash", "mean", "max",
+           "1", "2", "3-4", "5-8", "9-16", "17-32", "33+");
+    for (int s = 0; s < 3; s++) {
+        makers[s](keys, n_max);
+        for (int l = 0; l < 3; l++) {
+            int n = loads[l] * SLOTS;
+            run(sets[s], "charsum", legacy_hash, tbl, keys, n);
+            run(sets[s], "seeded", hashtable_hash, tbl, keys, n);
+        }
+    }
+
+    hashtable_kill(tbl);
+    for (int i = 0; i < n_max; i++) {
+        free(keys[i]);
+    }
+    free(keys);
+    return 0;
+}
@@ -0,0 +1,304 @@
+#define _POSIX_C_SOURCE 200809L
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "hashtable.h"
+
+/*
+ * Throughput and latency of the hashtable operations, printed as CSV
+ * with one row per measurement:
+ *
+ *   layout,dist,op,keys,capacity,load,ops,mops,p50_ns,p99_ns,p999_ns
+ *
+ * Tables hold from 512 keys (L1-resident) up to about the key count given as
+ * argument (default 2M, far beyond a typical LLC), each size eight times the
+ * last. Every size runs with each layout and each load factor in LOADS. The
+ * capacity is a power of two, as the swiss layout needs, and the key count is
+ * set to give exactly that load. Lookups draw keys uniformly or from a Zipf
+ * distribution (the hottest keys are spread over the table). The ops are:
+ *
+ *   insert     Add all keys, in random order, to a presized table.
+ *   hit        get() of stored keys.
+ *   hit_batch  hashtable_lookup_many() of stored keys, BATCH at a time.
+ *   miss       get() of keys never stored.
+ *   remove     Remove all keys, in another random order.
+ *
+ * mops is the phase's throughput in millions of ops per second. The
+ * percentiles come from every SAMPLE_EVERY-th op, timed on its own
+ * less the cost of reading the clock (per key for hit_batch).
+ */
+
+#define MIN_KEYS 512
+#define DEFAULT_MAX_KEYS (1 << 21)
+#define MIN_LOOKUPS (1 << 20)
+#define SAMPLE_EVERY 16
+#define BATCH 256
+#define KEYLEN 16
+#define ZIPF_S 0.99
+
+static const double LOADS[] = { 0.5, 0.75, 0.9, 0.95 };
+
+static const char *LAYOUT_NAMES[] = { "linear", "swiss", "robin_hood" };
+
+static uint64_t rng = 0x9e3779b97f4a7c15ULL;
+
+// Time taken by a pair of now_ns() calls, subtracted from samples.
+static uint64_t clock_cost;
+
+static inline uint64_t next_rand(void) {
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    return rng;
+}
+
+static inline uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+static void calibrate_clock(void) {
+    clock_cost = UINT64_MAX;
+    for (int i = 0; i < 10000; i++) {
+        uint64_t t = now_ns();
+        uint64_t d = now_ns() - t;
+        if (d < clock_cost) {
+            clock_cost = d;
+        }
+    }
+}
+
+// Latency of an op that started at t, less the cost of the clock.
+static inline uint64_t since(uint64_t t) {
+    uint64_t d = now_ns() - t;
+    return d > clock_cost ? d - clock_cost : 0;
+}
+
+// Random permutation of 0..n-1.
+static int *shuffled(int n) {
+    int *p = malloc(n * sizeof(*p));
+    for (int i = 0; i < n; i++) {
+        p[i] = i;
+    }
+    for (int i = n - 1; i > 0; i--) {
+        int j = next_rand() % (i + 1);
+        int t = p[i];
+        p[i] = p[j];
+        p[j] = t;
+    }
+    return p;
+}
+
+/*
+ * Fill q with count key indices below n, uniform or Zipf distributed.
+ * Zipf ranks are mapped through perm so hot keys are not neighbours.
+ */
+static void make_queries(int *q, int count, int n, bool zipf,
+                         const int *perm) {
+    if (!zipf) {
+        for (int i = 0; i < count; i++) {
+            q[i] = next_rand() % n;
+        }
+        return;
+    }
+    double *cdf = malloc(n * sizeof(*cdf));
+    double sum = 0;
+    for (int i = 0; i < n; i++) {
+        sum += 1 / pow(i + 1, ZIPF_S);
+        cdf[i] = sum;
+    }
+    for (int i = 0; i < count; i++) {
+        double u = (next_rand() >> 11) * 0x1.0p-53 * sum;
+        int lo = 0, hi = n - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (cdf[mid] < u) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        q[i] = perm[lo];
+    }
+    free(cdf);
+}
+
+static int cmp_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Timing of one phase: total time and sampled per-op latencies.
+struct phase {
+    uint64_t start;
+    uint64_t *samples;
+    int nsamples;
+};
+
+static void print_row(const char *layout, const char *dist, const char *op,
+                      int n, const struct hashtable_stats *st, long ops,
+                      struct phase *ph) {
+    double secs = (now_ns() - ph->start) * 1e-9;
+
+    qsort(ph->samples, ph->nsamples, sizeof(*ph->samples), cmp_u64);
+    uint64_t p50 = ph->samples[ph->nsamples / 2];
+    uint64_t p99 = ph->samples[(long)ph->nsamples * 99 / 100];
+    uint64_t p999 = ph->samples[(long)ph->nsamples * 999 / 1000];
+    printf("%s,%s,%s,%d,%d,%.3f,%ld,%.2f,%lu,%lu,%lu\n", layout, dist, op,
+           n, st->capacity, (double)n / st->capacity, ops, ops / secs / 1e6,
+           (unsigned long)p50, (unsigned long)p99, (unsigned long)p999);
+    fflush(stdout);
+    ph->nsamples = 0;
+}
+
+// Run the lookup phases for one distribution.
+static void run_lookups(hashtable *tbl, const char *layout, bool zipf, int n,
+                        char (*keys)[KEYLEN], char (*missing)[KEYLEN],
+                        const int *perm, struct phase *ph) {
+    const char *dist = zipf ? "zipf" : "uniform";
+    int count = n > MIN_LOOKUPS ? n : MIN_LOOKUPS;
+    int *q = malloc(count * sizeof(*q));
+    char **batch = malloc(BATCH * sizeof(*batch));
+    void **values = malloc(BATCH * sizeof(*values));
+    struct hashtable_stats st;
+    long found = 0;
+
+    hashtable_stats(tbl, &st);
+    make_queries(q, count, n, zipf, perm);
+
+    ph->start = now_ns();
+    for (int i = 0; i < count; i++) {
+        if (i % SAMPLE_EVERY == 0) {
+            uint64_t t = now_ns();
+            found += hashtable_get(tbl, keys[q[i]]) != NULL;
+            ph->samples[ph->nsamples++] = since(t);
+        } else {
+            found += hashtable_get(tbl, keys[q[i]]) != NULL;
+        }
+    }
+    print_row(layout, dist, "hit", n, &st, count, ph);
+
+    ph->start = now_ns();
+    for (int i = 0; i < count; i += BATCH) {
+        int m = count - i < BATCH ? count - i : BATCH;
+        for (int j = 0; j < m; j++) {
+            batch[j] = keys[q[i + j]];
+        }
+        uint64_t t = now_ns();
+        found += hashtable_lookup_many(tbl, batch, m, values);
+        uint64_t per_key = since(t) / m;
+        for (int j = 0; j < m; j += SAMPLE_EVERY) {
+            ph->samples[ph->nsamples++] = per_key;
+        }
+    }
+    print_row(layout, dist, "hit_batch", n, &st, count, ph);
+
+    ph->start = now_ns();
+    for (int i = 0; i < count; i++) {
+        if (i % SAMPLE_EVERY == 0) {
+            uint64_t t = now_ns();
+            found += hashtable_get(tbl, missing[q[i]]) != NULL;
+            ph->samples[ph->nsamples++] = since(t);
+        } else {
+            found += hashtable_get(tbl, missing[q[i]]) != NULL;
+        }
+    }
+    print_row(layout, dist, "miss", n, &st, count, ph);
+
+    if (found != 2L * count) {
+        fprintf(stderr, "hashtable_bench: %ld of %d hits found!\n",
+                found, 2 * count);
+        exit(EXIT_FAILURE);
+    }
+    free(values);
+    free(batch);
+    free(q);
+}
+
+// Fill a table of capacity slots to the given load and measure it.
+static void run(hashtable_layout layout, double load, int capacity,
+                char (*keys)[KEYLEN], char (*missing)[KEYLEN]) {
+    const char *name = LAYOUT_NAMES[layout];
+    int n = (int)(load * capacity);
+    hashtable_config cfg = { .capacity = capacity,
+                             .max_load = load + 0.01 < 1 ? load + 0.01 : 0.99,
+                             .layout = layout };
+    hashtable *tbl = hashtable_create(&cfg);
+    int count = n > MIN_LOOKUPS ? n : MIN_LOOKUPS;
+    struct phase ph = { .samples = malloc((count / SAMPLE_EVERY + BATCH)
+                                          * sizeof(*ph.samples)) };
+    struct hashtable_stats st;
+    int *order = shuffled(n);
+
+    ph.start = now_ns();
+    for (int i = 0; i < n; i++) {
+        if (i % SAMPLE_EVERY == 0) {
+            uint64_t t = now_ns();
+            hashtable_put(tbl, keys[order[i]], keys[order[i]]);
+            ph.samples[ph.nsamples++] = since(t);
+        } else {
+            hashtable_put(tbl, keys[order[i]], keys[order[i]]);
+        }
+    }
+    hashtable_stats(tbl, &st);
+    print_row(name, "uniform", "insert", n, &st, n, &ph);
+
+    run_lookups(tbl, name, false, n, keys, missing, order, &ph);
+    run_lookups(tbl, name, true, n, keys, missing, order, &ph);
+
+    free(order);
+    order = shuffled(n);
+    ph.start = now_ns();
+    for (int i = 0; i < n; i++) {
+        if (i % SAMPLE_EVERY == 0) {
+            uint64_t t = now_ns();
+            hashtable_remove(tbl, keys[order[i]]);
+            ph.samples[ph.nsamples++] = since(t);
+        } else {
+            hashtable_remove(tbl, keys[order[i]]);
+        }
+    }
+    print_row(name, "uniform", "remove", n, &st, n, &ph);
+
+    free(order);
+    free(ph.samples);
+    hashtable_kill(tbl);
+}
+
+int main(int argc, char **argv) {
+    int max_keys = argc > 1 ? atoi(argv[1]) : DEFAULT_MAX_KEYS;
+    if (max_keys < MIN_KEYS) {
+        max_keys = MIN_KEYS;
+    }
+
+    // The largest capacity is below 2 * max_keys.
+    int nkeys = 2 * max_keys;
+    char (*keys)[KEYLEN] = malloc((size_t)nkeys * KEYLEN);
+    char (*missing)[KEYLEN] = malloc((size_t)nkeys * KEYLEN);
+    for (int i = 0; i < nkeys; i++) {
+        snprintf(keys[i], KEYLEN, "key%d", i);
+        snprintf(missing[i], KEYLEN, "miss%d", i);
+    }
+
+    calibrate_clock();
+    printf("layout,dist,op,keys,capacity,load,ops,mops,"
+           "p50_ns,p99_ns,p999_ns\n");
+    for (long n = MIN_KEYS; n <= max_keys; n *= 8) {
+        for (size_t l = 0; l < sizeof(LOADS) / sizeof(LOADS[0]); l++) {
+            // Smallest power of two holding n keys at this load.
+            int capacity = HASHTABLE_MIN_CAPACITY;
+            while (capacity * LOADS[l] < n) {
+                capacity *= 2;
+            }
+            for (int layout = HASHTABLE_LINEAR;
+                 layout <= HASHTABLE_ROBIN_HOOD; layout++) {
+                run(layout, LOADS[l], capacity, keys, missing);
+            }
+        }
+    }
+    free(keys);
+    free(missing);
+    return 0;
+}
@@ -1,23 +1,513 @@
 #ifndef HASHTABLE_H
-#include "array_1d.h"
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #define MAXLEN 5000
 
+// Smallest number of slots. Tables grow from here as keys are added.
+#define HASHTABLE_MIN_CAPACITY 16
+
 #define HASHTABLE_H
 
+/*
+ * A hashtable with string keys and void * values, using open
+ * addressing. Keys are compared by content, so a key built at runtime
+ * finds an entry stored under another copy of the same string.
+ */
 typedef struct hashtable hashtable;
 
+/*
+ * A cursor over the keys of a hashtable, set up by hashtable_iter_begin().
+ * It can live on the stack and is advanced without allocating. The
+ * fields are private to the implementation.
+ */
+typedef struct hashtable_iter {
+    hashtable *tbl;
+    bool old;           // Walking the old slots of a migration.
+    int idx;            // Next slot to look at.
+} hashtable_iter;
+
+/*
+ * Type definition for a key hash function. Keys with equal content
+ * must give equal hashes for the same seed. The seed is the per-table
+ * seed chosen at creation.
+ */
+typedef uint64_t (*hashtable_hash_func)(const void *key, size_t len,
+                                        uint64_t seed);
+
+/*
+ * Slot layouts. Both use open addressing with the same parallel slot
+ * arrays for hashes, keys and values.
+ *
+ * HASHTABLE_LINEAR: Linear probing from the home slot, backward-shift
+ * deletion.
+ * HASHTABLE_ROBIN_HOOD: Linear probing where an inserted entry takes
+ * the slot of any resident closer to its own home, keeping probe
+ * sequence lengths (PSL) even. Each slot stores its displacement, so
+ * a lookup for a missing key stops once it has probed further than
+ * the entry in the current slot. Backward-shift deletion.
+ * HASHTABLE_SWISS: A separate array of control bytes holds a 7-bit tag
+ * of each slot's hash. Probing compares 16 control bytes at a time
+ * (with SSE2 where available), so a lookup usually touches one control
+ * cache line and then only the slots whose tag matches. The capacity
+ * is rounded up to a power of two.
+ */
+typedef enum hashtable_layout {
+    HASHTABLE_LINEAR,
+    HASHTABLE_SWISS,
+    HASHTABLE_ROBIN_HOOD,
+} hashtable_layout;
+
+/*
+ * Creation parameters for hashtable_create(). A zero-initialized
+ * config gives the defaults described for each field.
+ */
+typedef struct hashtable_config {
+    int capacity;                  // Initial number of slots.
+    hashtable_hash_func hash_func; // Key hash, hashtable_hash_bytes if NULL.
+    uint64_t seed;                 // Hash seed, random per table if 0.
+    double max_load;               // Max load factor in (0, 1), 0.75 if 0.
+    bool incremental;              // Spread rehashing over later inserts.
+    hashtable_layout layout;       // Slot layout, HASHTABLE_LINEAR if 0.
+    bool copy_keys;                // Store copies of keys in a key arena.
+    int build_threads;             // Threads of hashtable_build(), 1 if 0.
+} hashtable_config;
+
+/**
+ * hashtable_create() - Create an empty hashtable.
+ * @cfg: Creation parameters, or NULL for the defaults.
+ *
+ * The slot array doubles whenever an insert would take the load
+ * factor above max_load. By default all keys are rehashed into the
+ * new array at once. In incremental mode the old array is kept and
+ * each later insert migrates a few of its slots, so no single insert
+ * pays for the whole rehash.
+ *
+ * With copy_keys set, each added key is copied into chunks owned by the
+ * table, next to its length and hash, and callers may reuse their key
+ * buffers. The chunks are freed together by hashtable_kill(). Space of
+ * removed keys is given back when a full rehash finds more of it than
+ * of stored keys; incremental tables keep it until they are killed.
+ *
+ * Returns: A pointer to the new hashtable, or NULL if not enough
+ * memory was available.
+ */
+hashtable *hashtable_create(const hashtable_config *cfg);
+
+/**
+ * hashtable_empty() - Create an empty hashtable with default settings.
+ * @max: Initial number of slots.
+ *
+ * Returns: A pointer to the new hashtable.
+ */
 hashtable* hashtable_empty(int max);
 
+/**
+ * hashtable_insert() - Add a key without a value.
+ * @tbl: Table to manipulate.
+ * @key: Key to add. Must stay alive while stored in the table, unless
+ *       the table copies keys.
+ *
+ * Does nothing if the key is already present.
+ *
+ * Returns: The table, or NULL if not enough memory was available.
+ */
 hashtable* hashtable_insert(hashtable* tbl, char *key);
 
+/**
+ * hashtable_put() - Store a key/value pair.
+ * @tbl: Table to manipulate.
+ * @key: Key to store. Must stay alive while stored in the table, unless
+ *       the table copies keys.
+ * @value: Value to store for the key.
+ *
+ * Replaces the value if the key is already present.
+ *
+ * Returns: The table, or NULL if not enough memory was available.
+ */
+hashtable *hashtable_put(hashtable *tbl, char *key, void *value);
+
+/**
+ * hashtable_get() - Look up the value stored for a key.
+ * @tbl: Table to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: The value stored for the key, or NULL if the key is missing.
+ */
+void *hashtable_get(hashtable *tbl, const char *key);
+
+/**
+ * hashtable_get_or_insert() - Look up a key, adding it if missing.
+ * @tbl: Table to manipulate.
+ * @key: Key to look up. Stored if missing and must then stay alive,
+ *       unless the table copies keys.
+ * @value: Value to store if the key is missing.
+ *
+ * Returns: The value already stored for the key, or value if the key
+ * was added. NULL if the key was missing and not enough memory was
+ * available.
+ */
+void *hashtable_get_or_insert(hashtable *tbl, char *key, void *value);
+
+/**
+ * hashtable_remove() - Remove a key and its value.
+ * @tbl: Table to manipulate.
+ * @key: Key to remove.
+ *
+ * The following keys of the probe chain are shifted back into the
+ * freed slot, so removals leave no tombstones and lookups do not slow
+ * down under long-running insert/remove churn. Does nothing if the
+ * key is missing.
+ *
+ * Returns: The table.
+ */
 hashtable *hashtable_remove(hashtable *tbl, char *key);
+
+/**
+ * hashtable_lookup() - Find the slot holding a key.
+ * @tbl: Table to inspect.
+ * @key: Key to look up.
+ *
+ * Slot indices change when the table grows. Use hashtable_get() to
+ * reach the value stored for a key.
+ *
+ * Returns: The slot index of the key, or -1 if the key is missing.
+ */
 int hashtable_lookup(hashtable *tbl, char *key);
 
+/**
+ * hashtable_lookup_many() - Look up the values stored for a batch of keys.
+ * @tbl: Table to inspect.
+ * @keys: Keys to look up.
+ * @n: Number of keys.
+ * @values: Filled in with the value stored for each key, NULL for
+ *          missing keys.
+ *
+ * Hashes a run of keys and prefetches their home slots before probing
+ * for any of them, so the cache misses of a table larger than the
+ * cache overlap instead of being paid one key at a time. Gives the
+ * same results as calling hashtable_get() for each key.
+ *
+ * Returns: The number of keys found.
+ */
+int hashtable_lookup_many(hashtable *tbl, char **keys, int n, void **values);
+
+/**
+ * hashtable_insert_many() - Store a batch of key/value pairs.
+ * @tbl: Table to manipulate.
+ * @keys: Keys to store. Must stay alive while stored in the table,
+ *        unless the table copies keys.
+ * @values: Value to store for each key, or NULL to store only keys.
+ * @n: Number of keys.
+ *
+ * Same as calling hashtable_put() for each key in order, with the home
+ * slots prefetched ahead as in hashtable_lookup_many().
+ *
+ * Returns: The table, or NULL if not enough memory was available. The
+ * keys before the one that failed are stored.
+ */
+hashtable *hashtable_insert_many(hashtable *tbl, char **keys, void **values,
+                                 int n);
+
+/**
+ * hashtable_build() - Create a hashtable holding a batch of key/value pairs.
+ * @cfg: Creation parameters, or NULL for the defaults.
+ * @keys: Keys to store. Must stay alive while stored in the table,
+ *        unless the table copies keys.
+ * @values: Value to store for each key, or NULL to store only keys.
+ * @n: Number of keys.
+ *
+ * Gives the same table as hashtable_insert_many() on an empty table,
+ * with a later duplicate key replacing the value of an earlier one.
+ * The slot array is sized for all n keys up front, so it is never
+ * grown while the keys are placed.
+ *
+ * The linear layout is built with cfg->build_threads threads. The
+ * slots are split into one range per thread, and each thread places
+ * the keys whose home slot lies in its range. Keys whose probe runs
+ * past the end of their range are placed afterwards by the calling
+ * thread. The other layouts are built by the calling thread alone.
+ *
+ * Returns: A pointer to the new hashtable, or NULL if not enough
+ * memory was available.
+ */
+hashtable *hashtable_build(const hashtable_config *cfg, char **keys,
+                           void **values, int n);
+
+/**
+ * hashtable_iter_begin() - Start iterating over the keys of a table.
+ * @tbl: Table to inspect.
+ * @it: Iterator to set up.
+ *
+ * The iterator visits each key once, in slot order. Any put, insert or
+ * remove invalidates it, except the removals done by
+ * hashtable_iter_drain() itself.
+ *
+ * Returns: Nothing.
+ */
+void hashtable_iter_begin(hashtable *tbl, hashtable_iter *it);
+
+/**
+ * hashtable_iter_next() - Advance an iterator to the next key.
+ * @it: Iterator to advance.
+ * @key: Set to the key.
+ * @value: Set to the value stored for the key.
+ *
+ * Returns: True if a key was found, false when all keys have been
+ * visited.
+ */
+bool hashtable_iter_next(hashtable_iter *it, char **key, void **value);
+
+/**
+ * hashtable_iter_drain() - Remove the next key and hand it over.
+ * @it: Iterator to advance.
+ * @key: Set to the removed key.
+ * @value: Set to the value that was stored for the key.
+ *
+ * Like hashtable_iter_next(), but also removes the key from the table,
+ * so draining with one iterator empties the table in one pass over its
+ * slots. A key copied by the table stays valid until the next insert
+ * into the table or its kill.
+ *
+ * Returns: True if a key was removed, false when the table is empty.
+ */
+bool hashtable_iter_drain(hashtable_iter *it, char **key, void **value);
+
+/**
+ * hashtable_hash() - Compute the home slot of a key.
+ * @tbl: Table the key belongs to.
+ * @key: Key to hash.
+ *
+ * Returns: The slot index where probing for the key starts.
+ */
 int hashtable_hash(hashtable *tbl, char *key);
 
+/**
+ * hashtable_hash_bytes() - The built-in 64-bit key hash.
+ * @key: Pointer to the key bytes.
+ * @len: Number of bytes in the key.
+ * @seed: Hash seed.
+ *
+ * A wyhash-style hash that mixes the key 8 bytes at a time through
+ * 64x64->128 bit multiplications. Used when no hash_func is given.
+ *
+ * Returns: The 64-bit hash of the key.
+ */
+uint64_t hashtable_hash_bytes(const void *key, size_t len, uint64_t seed);
+
+// Number of buckets in the PSL histogram. The last one counts all
+// longer PSLs.
+#define HASHTABLE_PSL_BUCKETS 16
+
+/*
+ * Statistics filled in by hashtable_stats(). The probe sequence length
+ * (PSL) of a key is the number of slots probed past its home slot, or
+ * of groups past its first group in the swiss layout.
+ *
+ * The hit, miss and resize counters are kept by the table as it is
+ * used. Building with HASHTABLE_NO_STATS defined compiles them out,
+ * and they are then reported as 0.
+ */
+struct hashtable_stats {
+    int size;           // Number of keys.
+    int capacity;       // Number of slots.
+    double load;        // size / capacity.
+    int max_psl;        // Longest PSL of any key.
+    double mean_psl;    // Mean PSL over all keys.
+    int psl_hist[HASHTABLE_PSL_BUCKETS]; // Number of keys per PSL.
+    int max_cluster;    // Longest run of slots without a free one.
+    long resizes;       // Grows and rebuilds since creation.
+    size_t bytes;       // Memory held by the table, keys copied included.
+    long hits;          // Lookups that found their key.
+    long misses;        // Lookups that did not.
+};
+
+/**
+ * hashtable_stats() - Collect statistics for a table.
+ * @tbl: Table to inspect.
+ * @out: Filled in with the statistics.
+ *
+ * Walks every slot, so it costs O(capacity). Lookups are the calls to
+ * hashtable_get(), hashtable_lookup() and hashtable_lookup_many(). In
+ * the swiss layout deleted slots also extend a cluster, as probes pass
+ * over them.
+ *
+ * Returns: Nothing.
+ */
+void hashtable_stats(const hashtable *tbl, struct hashtable_stats *out);
+
 void hashtable_kill(hashtable *tbl);
-#endif
\ No newline at end of file
+
+/*
+ * A read-only table image, mapped from a file written by
+ * hashtable_save(). The file holds its own slot array and key bytes at
+ * fixed offsets, so opening it only maps the file and checks its
+ * header. Processes mapping the same file share its pages in the page
+ * cache.
+ *
+ * Values are saved as their 64-bit bit pattern. They are only
+ * meaningful in another process if they encode integers or offsets
+ * rather than pointers.
+ */
+typedef struct hashtable_image hashtable_image;
+
+/**
+ * hashtable_save() - Write a table image file.
+ * @tbl: Table to save.
+ * @path: File to write. Replaced atomically if it exists.
+ *
+ * Only tables using the built-in hash can be saved, as the image must
+ * hash keys the same way in any process.
+ *
+ * Returns: 0 on success, -1 if the table has a custom hash function,
+ * memory ran out or the file could not be written.
+ */
+int hashtable_save(const hashtable *tbl, const char *path);
+
+/**
+ * hashtable_open_mmap() - Map a table image file read-only.
+ * @path: File written by hashtable_save().
+ *
+ * Checks the format version and that all offsets lie inside the file,
+ * but does not read the slots or keys. Use hashtable_image_verify() to
+ * check the contents against the checksum.
+ *
+ * Returns: The mapped image, or NULL if the file could not be mapped
+ * or is not a valid image of this version.
+ */
+hashtable_image *hashtable_open_mmap(const char *path);
+
+/**
+ * hashtable_image_get() - Look up the value saved for a key.
+ * @img: Image to inspect.
+ * @key: Key to look up.
+ * @value: Set to the saved value if the key is found. May be NULL.
+ *
+ * Returns: True if the key is in the image, otherwise false.
+ */
+bool hashtable_image_get(const hashtable_image *img, const char *key,
+                         uint64_t *value);
+
+/**
+ * hashtable_image_size() - Count the keys in an image.
+ * @img: Image to inspect.
+ *
+ * Returns: The number of keys.
+ */
+int hashtable_image_size(const hashtable_image *img);
+
+/**
+ * hashtable_image_verify() - Check an image against its checksum.
+ * @img: Image to check.
+ *
+ * Reads the whole file.
+ *
+ * Returns: True if the slots and keys match the checksum in the header.
+ */
+bool hashtable_image_verify(const hashtable_image *img);
+
+/**
+ * hashtable_image_close() - Unmap an image.
+ * @img: Image to close.
+ *
+ * Returns: Nothing.
+ */
+void hashtable_image_close(hashtable_image *img);
+
+/*
+ * A concurrent variant of the hashtable, split into shards by the high
+ * bits of the key hash. Writers (put, remove) take a per-shard lock.
+ * Readers (get) take no lock and never retry: a slot's hash is
+ * published last with release ordering, entries are never moved in
+ * place, and a grown shard swaps in a fully built slot array. Readers
+ * therefore finish in a bounded number of probes whatever the writers
+ * do.
+ *
+ * The table keeps its own copy of every key. Removed keys and slot
+ * arrays replaced by a grow may still be in use by readers, so they
+ * are kept until hashtable_concurrent_reclaim() or
+ * hashtable_concurrent_kill().
+ */
+typedef struct hashtable_concurrent hashtable_concurrent;
+
+/**
+ * hashtable_concurrent_create() - Create an empty concurrent hashtable.
+ * @shards: Number of shards, rounded up to a power of two. Use a few
+ *          times the number of writer threads.
+ * @cfg: Creation parameters, or NULL for the defaults. capacity is per
+ *       shard. layout and incremental are ignored.
+ *
+ * Returns: A pointer to the new table, or NULL if not enough memory
+ * was available.
+ */
+hashtable_concurrent *hashtable_concurrent_create(int shards,
+                                                  const hashtable_config *cfg);
+
+/**
+ * hashtable_concurrent_put() - Store a key/value pair.
+ * @tbl: Table to manipulate.
+ * @key: Key to store. The table stores a copy.
+ * @value: Value to store for the key.
+ *
+ * Replaces the value if the key is already present. Safe to call from
+ * any number of threads.
+ *
+ * Returns: 0 on success, -1 if not enough memory was available.
+ */
+int hashtable_concurrent_put(hashtable_concurrent *tbl, const char *key,
+                             void *value);
+
+/**
+ * hashtable_concurrent_get() - Look up the value stored for a key.
+ * @tbl: Table to inspect.
+ * @key: Key to look up.
+ *
+ * Lock-free and wait-free. Safe to call concurrently with writers.
+ *
+ * Returns: The value stored for the key, or NULL if the key is missing.
+ */
+void *hashtable_concurrent_get(hashtable_concurrent *tbl, const char *key);
+
+/**
+ * hashtable_concurrent_remove() - Remove a key and its value.
+ * @tbl: Table to manipulate.
+ * @key: Key to remove.
+ *
+ * Does nothing if the key is missing.
+ *
+ * Returns: Nothing.
+ */
+void hashtable_concurrent_remove(hashtable_concurrent *tbl, const char *key);
+
+/**
+ * hashtable_concurrent_size() - Count the keys in the table.
+ * @tbl: Table to inspect.
+ *
+ * Returns: The number of keys. Approximate while writers are active.
+ */
+int hashtable_concurrent_size(hashtable_concurrent *tbl);
+
+/**
+ * hashtable_concurrent_reclaim() - Free removed keys and old slot arrays.
+ * @tbl: Table to manipulate.
+ *
+ * Must only be called when no other thread is using the table, e.g.
+ * between request batches.
+ *
+ * Returns: Nothing.
+ */
+void hashtable_concurrent_reclaim(hashtable_concurrent *tbl);
+
+/**
+ * hashtable_concurrent_kill() - Destroy a concurrent hashtable.
+ * @tbl: Table to destroy.
+ *
+ * Frees the table's key copies. Values are owned by the caller.
+ *
+ * Returns: Nothing.
+ */
+void hashtable_concurrent_kill(hashtable_concurrent *tbl);
+#endif
@@ -0,0 +1,184 @@
+#ifndef HASHTABLE_TEMPLATE_H
+#define HASHTABLE_TEMPLATE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/*
+ * A header-only hashtable template. HASHTABLE_DEFINE(name, K, V,
+ * hash_fn, eq_fn) defines the type name, holding keys of type K and
+ * values of type V inline in one flat array of entries, with these
+ * static inline functions:
+ *
+ *   name *name_create(int capacity);
+ *   name *name_put(name *tbl, K key, V value);
+ *   V *name_get(const name *tbl, K key);
+ *   name *name_remove(name *tbl, K key);
+ *   int name_size(const name *tbl);
+ *   void name_kill(name *tbl);
+ *
+ * hash_fn(K) must return a uint64_t and eq_fn(K, K) must return true
+ * for equal keys. Both can be functions or macros. They are called
+ * directly, so the compiler can inline them into the probe loop,
+ * unlike the compare_function callbacks of the ADT library.
+ *
+ * The table uses linear probing with backward-shift removal over a
+ * power of two number of slots. Hashes go through a fibonacci multiply
+ * before their top bits pick the home slot, so a plain identity hash
+ * works for integer keys. A separate byte per slot marks it as used,
+ * so every value of K is a valid key.
+ *
+ * name_create and name_put return NULL if not enough memory was
+ * available. name_get returns a pointer to the stored value, valid
+ * until the next put or remove, or NULL if the key is missing.
+ *
+ * Example:
+ *
+ *   static inline uint64_t id_hash(uint32_t k) { return k; }
+ *   #define ID_EQ(a, b) ((a) == (b))
+ *   HASHTABLE_DEFINE(id_map, uint32_t, double, id_hash, ID_EQ)
+ *
+ *   id_map *m = id_map_create(0);
+ *   id_map_put(m, 17, 0.5);
+ *   double *v = id_map_get(m, 17);
+ */
+
+// 2^64 / phi, the multiplier of fibonacci hashing.
+#define HASHTABLE_TEMPLATE_FIB 0x9e3779b97f4a7c15ULL
+
+// Smallest number of slots.
+#define HASHTABLE_TEMPLATE_MIN_CAPACITY 16
+
+#define HASHTABLE_DEFINE(name, K, V, hash_fn, eq_fn)                        \
+                                                                            \
+typedef struct name##_entry {                                               \
+    K key;                                                                  \
+    V value;                                                                \
+} name##_entry;                                                             \
+                                                                            \
+typedef struct name {                                                       \
+    int size;               /* Number of keys. */                           \
+    int max;                /* Number of slots, a power of two. */          \
+    int shift;              /* 64 - log2(max). */                           \
+    uint8_t *used;          /* used[i] is set if slot i holds a key. */     \
+    name##_entry *entries;                                                  \
+} name;                                                                     \
+                                                                            \
+static inline int name##_home(const name *tbl, K key) {                     \
+    return (int)(((uint64_t)hash_fn(key) * HASHTABLE_TEMPLATE_FIB)          \
+                 >> tbl->shift);                                            \
+}                                                                           \
+                                                                            \
+/* Slot holding key, or the free slot ending its chain. */                  \
+static inline int name##_find(const name *tbl, K key) {                     \
+    int mask = tbl->max - 1;                                                \
+    int idx = name##_home(tbl, key);                                        \
+                                                                            \
+    while (tbl->used[idx] && !(eq_fn(tbl->entries[idx].key, key))) {        \
+        idx = (idx + 1) & mask;                                             \
+    }                                                                       \
+    return idx;                                                             \
+}                                                                           \
+                                                                            \
+static inline int name##_set_capacity(name *tbl, int max) {                 \
+    uint8_t *used = calloc(max, sizeof(*used));                             \
+    name##_entry *entries = malloc(max * sizeof(*entries));                 \
+    if (used == NULL || entries == NULL) {                                  \
+        free(used);                                                         \
+        free(entries);                                                      \
+        return -1;                                                          \
+    }                                                                       \
+    uint8_t *old_used = tbl->used;                                          \
+    name##_entry *old = tbl->entries;                                       \
+    int old_max = tbl->max;                                                 \
+                                                                            \
+    tbl->used = used;                                                       \
+    tbl->entries = entries;                                                 \
+    tbl->max = max;                                                         \
+    for (tbl->shift = 64; max > 1; max /= 2) {                              \
+        tbl->shift--;                                                       \
+    }                                                                       \
+    for (int i = 0; i < old_max; i++) {                                     \
+        if (old_used[i]) {                                                  \
+            int idx = name##_find(tbl, old[i].key);                         \
+            tbl->used[idx] = 1;                                             \
+            tbl->entries[idx] = old[i];                                     \
+        }                                                                   \
+    }                                                                       \
+    free(old_used);                                                         \
+    free(old);                                                              \
+    return 0;                                                               \
+}                                                                           \
+                                                                            \
+static inline name *name##_create(int capacity) {                           \
+    name *tbl = calloc(1, sizeof(*tbl));                                    \
+    int max = HASHTABLE_TEMPLATE_MIN_CAPACITY;                              \
+                                                                            \
+    while (max < capacity) {                                                \
+        max *= 2;                                                           \
+    }                                                                       \
+    if (tbl != NULL && name##_set_capacity(tbl, max) < 0) {                 \
+        free(tbl);                                                          \
+        tbl = NULL;                                                         \
+    }                                                                       \
+    return tbl;                                                             \
+}                                                                           \
+                                                                            \
+static inline name *name##_put(name *tbl, K key, V value) {                 \
+    int idx = name##_find(tbl, key);                                        \
+                                                                            \
+    if (!tbl->used[idx]) {                                                  \
+        /* Grow at a load factor of 3/4. */                                 \
+        if (4 * (tbl->size + 1) > 3 * tbl->max) {                           \
+            if (name##_set_capacity(tbl, 2 * tbl->max) < 0) {               \
+                return NULL;                                                \
+            }                                                               \
+            idx = name##_find(tbl, key);                                    \
+        }                                                                   \
+        tbl->used[idx] = 1;                                                 \
+        tbl->entries[idx].key = key;                                        \
+        tbl->size++;                                                        \
+    }                                                                       \
+    tbl->entries[idx].value = value;                                        \
+    return tbl;                                                             \
+}                                                                           \
+                                                                            \
+static inline V *name##_get(const name *tbl, K key) {                       \
+    int idx = name##_find(tbl, key);                                        \
+                                                                            \
+    return tbl->used[idx] ? &tbl->entries[idx].value : NULL;                \
+}                                                                           \
+                                                                            \
+static inline name *name##_remove(name *tbl, K key) {                       \
+    int mask = tbl->max - 1;                                                \
+    int hole = name##_find(tbl, key);                                       \
+                                                                            \
+    if (!tbl->used[hole]) {                                                 \
+        return tbl;                                                         \
+    }                                                                       \
+    /* Shift back later keys of the chain that may move to the hole. */     \
+    for (int idx = (hole + 1) & mask; tbl->used[idx];                       \
+         idx = (idx + 1) & mask) {                                          \
+        int home = name##_home(tbl, tbl->entries[idx].key);                 \
+        if (((idx - home) & mask) >= ((idx - hole) & mask)) {               \
+            tbl->entries[hole] = tbl->entries[idx];                         \
+            hole = idx;                                                     \
+        }                                                                   \
+    }                                                                       \
+    tbl->used[hole] = 0;                                                    \
+    tbl->size--;                                                            \
+    return tbl;                                                             \
+}                                                                           \
+                                                                            \
+static inline int name##_size(const name *tbl) {                            \
+    return tbl->size;                                                       \
+}                                                                           \
+                                                                            \
+static inline void name##_kill(name *tbl) {                                 \
+    free(tbl->used);                                                        \
+    free(tbl->entries);                                                     \
+    free(tbl);                                                              \
+}
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef INT_HASHTABLE_H
+#define INT_HASHTABLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * A hashtable specialized for 64-bit integer keys with void * values,
+ * the integer counterpart of hashtable like int_array_1d is of
+ * array_1d. Keys and values are stored inline in one flat array of
+ * slots, so a probe compares keys directly without hashing a string or
+ * following a pointer. Slots are found by fibonacci hashing (multiply
+ * by 2^64 / phi, keep the top bits) and linear probing in a power of
+ * two sized array.
+ *
+ * A key of 0 marks a free slot. The real key 0 is stored outside the
+ * slot array, so every uint64_t value can be used as a key.
+ */
+typedef struct int_hashtable int_hashtable;
+
+/**
+ * int_hashtable_create() - Create an empty integer-keyed hashtable.
+ * @capacity: Initial number of slots, rounded up to a power of two.
+ *
+ * The slot array doubles whenever an insert would take the load
+ * factor above 0.75.
+ *
+ * Returns: A pointer to the new table, or NULL if not enough memory
+ * was available.
+ */
+int_hashtable *int_hashtable_create(int capacity);
+
+/**
+ * int_hashtable_put() - Store a key/value pair.
+ * @tbl: Table to manipulate.
+ * @key: Key to store.
+ * @value: Value to store for the key.
+ *
+ * Replaces the value if the key is already present.
+ *
+ * Returns: The table, or NULL if not enough memory was available.
+ */
+int_hashtable *int_hashtable_put(int_hashtable *tbl, uint64_t key,
+                                 void *value);
+
+/**
+ * int_hashtable_get() - Look up the value stored for a key.
+ * @tbl: Table to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: The value stored for the key, or NULL if the key is missing.
+ */
+void *int_hashtable_get(const int_hashtable *tbl, uint64_t key);
+
+/**
+ * int_hashtable_has_key() - Check if a key is present.
+ * @tbl: Table to inspect.
+ * @key: Key to look up.
+ *
+ * Returns: True if the key is present, also if its value is NULL.
+ */
+bool int_hashtable_has_key(const int_hashtable *tbl, uint64_t key);
+
+/**
+ * int_hashtable_remove() - Remove a key and its value.
+ * @tbl: Table to manipulate.
+ * @key: Key to remove.
+ *
+ * Shifts the rest of the probe chain back, leaving no tombstones.
+ * Does nothing if the key is missing.
+ *
+ * Returns: The table.
+ */
+int_hashtable *int_hashtable_remove(int_hashtable *tbl, uint64_t key);
+
+/**
+ * int_hashtable_size() - Count the keys in the table.
+ * @tbl: Table to inspect.
+ *
+ * Returns: The number of keys.
+ */
+int int_hashtable_size(const int_hashtable *tbl);
+
+/**
+ * int_hashtable_kill() - Destroy an integer-keyed hashtable.
+ * @tbl: Table to destroy.
+ *
+ * Values are owned by the caller.
+ *
+ * Returns: Nothing.
+ */
+void int_hashtable_kill(int_hashtable *tbl);
+
+#endif
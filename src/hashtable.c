@@ -1,66 +1,1700 @@
+#define _POSIX_C_SOURCE 200809L
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
 #include "hashtable.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Mixing constants of the built-in hash (wyhash's secret).
+#define HASH_P0 0xa0761d6478bd642fULL
+#define HASH_P1 0xe7037ed1a0b428dbULL
+#define HASH_P2 0x8ebc6af09c88c6e3ULL
+#define HASH_P3 0x589965cc75374cc3ULL
+
+// Default maximum load factor.
+#define HASHTABLE_MAX_LOAD 0.75
+
+// Old slots migrated per insert while rehashing incrementally. Must
+// exceed 1 / max_load for the migration to end before the next grow.
+#define HASHTABLE_MIGRATE_STEP 16
+
+// Control bytes of the swiss layout. A full slot holds the low 7 bits
+// of its hash, so a set high bit means empty or deleted.
+#define CTRL_EMPTY 0x80
+#define CTRL_DELETED 0xfe
+
+// Number of control bytes scanned per probe in the swiss layout.
+#define GROUP_WIDTH 16
+
+// Keys hashed and prefetched ahead of their probes by the batch calls.
+#define HASHTABLE_BATCH 32
+
+// Most threads hashtable_build() starts, and the fewest keys it gives
+// each of them.
+#define BUILD_MAX_THREADS 64
+#define BUILD_MIN_KEYS 65536
+
+// Bytes per chunk of the key arena. Longer keys get a chunk of their own.
+#define ARENA_CHUNK 65536
+
+// Table image file format. IMAGE_MAGIC also catches a byte order
+// mismatch, as it is compared as a 64-bit word.
+#define IMAGE_MAGIC 0x31474d4948534148ULL   // "HASHIMG1" little-endian.
+#define IMAGE_VERSION 1
+#define IMAGE_ALIGN 64
+
+// Add n to one of the table's usage counters, unless compiled out.
+#ifdef HASHTABLE_NO_STATS
+#define STAT_ADD(tbl, counter, n) ((void)0)
+#else
+#define STAT_ADD(tbl, counter, n) ((tbl)->counter += (n))
+#endif
+
+/*
+ * A slot array. Keys, values and the full hash of each key are kept
+ * in parallel arrays. Probing walks the hashes, or the control bytes
+ * in the swiss layout, and only touches a key when its hash matches.
+ * hashes[i] == 0 marks a free slot.
+ */
+struct slots {
+    int max;            // Number of slots.
+    int tombstones;     // Deleted control bytes (swiss layout).
+    uint8_t *ctrl;      // max + GROUP_WIDTH control bytes (swiss layout).
+    uint32_t *dist;     // Displacement from the home slot (robin hood).
+    uint64_t *hashes;
+    char **keys;
+    void **values;
+};
+
+// A key copied into the key arena, with the length and hash of its bytes.
+struct arena_key {
+    uint64_t hash;
+    uint32_t len;
+    char str[];
+};
+
+struct arena_chunk {
+    struct arena_chunk *next;
+    size_t size;        // Bytes in data.
+    size_t used;        // Bytes handed out from data.
+    _Alignas(struct arena_key) char data[];
+};
+
+/*
+ * Bump allocator for key copies. Keys are never freed one by one. The
+ * bytes of removed keys are only counted, and given back when the
+ * arena is compacted or killed.
+ */
+struct key_arena {
+    struct arena_chunk *head;   // Chunk handing out bytes, then older ones.
+    size_t live;                // Bytes of stored keys.
+    size_t dead;                // Bytes of removed keys.
+};
+
 struct hashtable {
-    int max;
-    array_1d *arr;
+    hashtable_layout layout;
+    int size;           // Number of keys, in cur and old.
+    double max_load;    // Grow when size would exceed max_load * cur.max.
+    bool incremental;   // Migrate old a few slots per insert.
+    bool copy_keys;     // Keys are stored in arena, not by the caller.
+    struct key_arena arena;
+    struct slots cur;
+    struct slots old;   // Previous slots while migrating, else hashes NULL.
+    int old_start;      // First old slot to migrate.
+    int migrated;       // Number of old slots migrated so far.
+    hashtable_hash_func hash_func;
+    uint64_t seed;
+#ifndef HASHTABLE_NO_STATS
+    long hits;          // Lookups that found their key.
+    long misses;        // Lookups that did not.
+    long resizes;
+#endif
 };
 
-hashtable* hashtable_empty(int max) {
-    array_1d *arr = array_1d_create(0, max, NULL);
+// Multiply two 64-bit words to 128 bits, low half to *a, high to *b.
+static inline void hash_mum(uint64_t *a, uint64_t *b) {
+#ifdef __SIZEOF_INT128__
+    unsigned __int128 r = (unsigned __int128)*a * *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32;
+    uint64_t la = (uint32_t)*a, lb = (uint32_t)*b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32), c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+// Multiply and fold the two halves of the product together.
+static inline uint64_t hash_mix(uint64_t a, uint64_t b) {
+    hash_mum(&a, &b);
+    return a ^ b;
+}
+
+static inline uint64_t hash_read64(const uint8_t *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint64_t hash_read32(const uint8_t *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+uint64_t hashtable_hash_bytes(const void *key, size_t len, uint64_t seed) {
+    const uint8_t *p = key;
+    uint64_t a, b;
+
+    seed ^= hash_mix(seed ^ HASH_P0, HASH_P1);
+    if (len <= 16) {
+        if (len >= 4) {
+            // Two possibly overlapping 4-byte reads from each end.
+            size_t mid = (len >> 3) << 2;
+            a = (hash_read32(p) << 32) | hash_read32(p + mid);
+            b = (hash_read32(p + len - 4) << 32)
+                | hash_read32(p + len - 4 - mid);
+        } else if (len > 0) {
+            a = ((uint64_t)p[0] << 16) | ((uint64_t)p[len >> 1] << 8)
+                | p[len - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = len;
+        if (i > 48) {
+            // Three independent lanes keep the multipliers busy.
+            uint64_t lane1 = seed, lane2 = seed;
+            do {
+                seed = hash_mix(hash_read64(p) ^ HASH_P1,
+                                hash_read64(p + 8) ^ seed);
+                lane1 = hash_mix(hash_read64(p + 16) ^ HASH_P2,
+                                 hash_read64(p + 24) ^ lane1);
+                lane2 = hash_mix(hash_read64(p + 32) ^ HASH_P3,
+                                 hash_read64(p + 40) ^ lane2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= lane1 ^ lane2;
+        }
+        while (i > 16) {
+            seed = hash_mix(hash_read64(p) ^ HASH_P1,
+                            hash_read64(p + 8) ^ seed);
+            p += 16;
+            i -= 16;
+        }
+        a = hash_read64(p + i - 16);
+        b = hash_read64(p + i - 8);
+    }
+    a ^= HASH_P1;
+    b ^= seed;
+    hash_mum(&a, &b);
+    return hash_mix(a ^ HASH_P0 ^ len, b ^ HASH_P1);
+}
+
+// Pick a seed that differs between tables and between runs.
+static uint64_t hashtable_random_seed(const void *salt) {
+    static uint64_t counter = 0;
+    uint64_t s = (uint64_t)time(NULL) ^ ((uint64_t)clock() << 32);
+
+    s = hash_mix(s ^ HASH_P2, (uint64_t)(uintptr_t)salt ^ HASH_P3);
+    s = hash_mix(s ^ ++counter, HASH_P0);
+    return s ? s : HASH_P0;
+}
+
+// Distance from slot a forward to slot b in a table of max slots.
+static inline int cyclic_dist(int a, int b, int max) {
+    return b >= a ? b - a : b + max - a;
+}
+
+// Hash of a key. 0 is reserved for free slots and mapped to 1.
+static inline uint64_t key_hash(const hashtable *tbl, const char *key) {
+    uint64_t h = tbl->hash_func(key, strlen(key), tbl->seed);
+
+    return h ? h : 1;
+}
+
+static inline int home_slot(uint64_t h, int max) {
+    return (int)(h % (uint64_t)max);
+}
+
+// First slot of the first group probed for h in the swiss layout.
+// The low 7 bits go to the control byte and are not reused here.
+static inline int group_slot(uint64_t h, int max) {
+    return (int)((h >> 7) & (uint64_t)(max - 1));
+}
+
+static void slots_free(struct slots *s) {
+    free(s->ctrl);
+    free(s->dist);
+    free(s->hashes);
+    free(s->keys);
+    free(s->values);
+    s->ctrl = NULL;
+    s->dist = NULL;
+    s->hashes = NULL;
+    s->keys = NULL;
+    s->values = NULL;
+}
+
+static int slots_init(struct slots *s, int max, hashtable_layout layout) {
+    s->max = max;
+    s->tombstones = 0;
+    s->ctrl = NULL;
+    s->dist = NULL;
+    s->hashes = calloc(max, sizeof(*s->hashes));
+    s->keys = calloc(max, sizeof(*s->keys));
+    s->values = calloc(max, sizeof(*s->values));
+    if (layout == HASHTABLE_SWISS) {
+        s->ctrl = malloc(max + GROUP_WIDTH);
+        if (s->ctrl != NULL) {
+            memset(s->ctrl, CTRL_EMPTY, max + GROUP_WIDTH);
+        }
+    }
+    if (layout == HASHTABLE_ROBIN_HOOD) {
+        s->dist = calloc(max, sizeof(*s->dist));
+    }
+    if (s->hashes == NULL || s->keys == NULL || s->values == NULL
+        || (layout == HASHTABLE_SWISS && s->ctrl == NULL)
+        || (layout == HASHTABLE_ROBIN_HOOD && s->dist == NULL)) {
+        slots_free(s);
+        return -1;
+    }
+    return 0;
+}
+
+// ===========KEY ARENA============
+
+// Bytes taken by a key of len bytes, keeping the next one aligned.
+static inline size_t arena_size(size_t len) {
+    size_t a = _Alignof(struct arena_key);
+
+    return (sizeof(struct arena_key) + len + 1 + a - 1) & ~(a - 1);
+}
+
+static inline struct arena_key *arena_key_of(char *str) {
+    return (struct arena_key *)(str - offsetof(struct arena_key, str));
+}
+
+// Add a chunk of at least size bytes in front of the arena's chunks.
+static int arena_grow(struct key_arena *a, size_t size) {
+    if (size < ARENA_CHUNK) {
+        size = ARENA_CHUNK;
+    }
+    struct arena_chunk *c = malloc(sizeof(*c) + size);
+    if (c == NULL) {
+        return -1;
+    }
+    c->size = size;
+    c->used = 0;
+    c->next = a->head;
+    a->head = c;
+    return 0;
+}
+
+// Copy a key of len bytes with hash h. Returns the copy, or NULL if out
+// of memory.
+static char *arena_store(struct key_arena *a, const char *key, size_t len,
+                         uint64_t h) {
+    size_t size = arena_size(len);
+
+    if ((a->head == NULL || a->head->size - a->head->used < size)
+        && arena_grow(a, size) < 0) {
+        return NULL;
+    }
+    struct arena_key *k = (struct arena_key *)(a->head->data + a->head->used);
+    a->head->used += size;
+    a->live += size;
+    k->hash = h;
+    k->len = (uint32_t)len;
+    memcpy(k->str, key, len + 1);
+    return k->str;
+}
+
+// Account for a key copy that is no longer stored.
+static void arena_release(struct key_arena *a, char *str) {
+    size_t size = arena_size(arena_key_of(str)->len);
+
+    a->live -= size;
+    a->dead += size;
+}
+
+static void arena_free(struct key_arena *a) {
+    while (a->head != NULL) {
+        struct arena_chunk *c = a->head;
+        a->head = c->next;
+        free(c);
+    }
+    a->live = 0;
+    a->dead = 0;
+}
+
+// ===========LINEAR PROBING============
+
+// Find the slot holding key, probing from slot idx. Returns -1 if missing.
+static int probe_find(const struct slots *s, int idx, const char *key,
+                      uint64_t h) {
+    while (s->hashes[idx] != 0) {
+        // The key bytes are only compared when the full hash matches.
+        if (s->hashes[idx] == h && strcmp(s->keys[idx], key) == 0) {
+            return idx;
+        }
+        if (++idx == s->max) {
+            idx = 0;
+        }
+    }
+    return -1;
+}
+
+// Find the first free slot at or after idx. The load factor keeps
+// at least one slot free.
+static int probe_free(const struct slots *s, int idx) {
+    while (s->hashes[idx] != 0) {
+        if (++idx == s->max) {
+            idx = 0;
+        }
+    }
+    return idx;
+}
+
+/*
+ * Clear slot hole and shift the following keys of its probe chain
+ * back, so that every key stays reachable from its home slot without
+ * leaving a tombstone behind.
+ */
+static void backward_shift(struct slots *s, int hole) {
+    int idx = hole;
+
+    for (;;) {
+        if (++idx == s->max) {
+            idx = 0;
+        }
+        if (s->hashes[idx] == 0) {
+            break;
+        }
+        int home = home_slot(s->hashes[idx], s->max);
+        // A key may only move back if the hole is not before its home.
+        if (cyclic_dist(home, idx, s->max) >= cyclic_dist(hole, idx, s->max)) {
+            s->hashes[hole] = s->hashes[idx];
+            s->keys[hole] = s->keys[idx];
+            s->values[hole] = s->values[idx];
+            hole = idx;
+        }
+    }
+    s->hashes[hole] = 0;
+    s->keys[hole] = NULL;
+    s->values[hole] = NULL;
+}
+
+// ===========ROBIN HOOD PROBING============
+
+/*
+ * Find the slot holding key. Entries along a chain are ordered so that
+ * none is further from home than the one probing past it, so the
+ * search stops as soon as the probed slot's displacement is smaller
+ * than the distance already travelled. Returns -1 if the key is
+ * missing.
+ */
+static int robin_find(const struct slots *s, const char *key, uint64_t h) {
+    int idx = home_slot(h, s->max);
+
+    for (uint32_t d = 0; s->hashes[idx] != 0 && d <= s->dist[idx]; d++) {
+        if (s->hashes[idx] == h && strcmp(s->keys[idx], key) == 0) {
+            return idx;
+        }
+        if (++idx == s->max) {
+            idx = 0;
+        }
+    }
+    return -1;
+}
+
+/*
+ * Store an entry. Walking from its home slot, the entry takes the
+ * place of the first resident that is closer to its own home, and the
+ * resident moves on to find a slot further down the chain. Returns the
+ * slot where the new entry ended up.
+ */
+static int robin_store(struct slots *s, uint64_t h, char *key, void *value) {
+    int idx = home_slot(h, s->max);
+    int placed = -1;
+    uint32_t d = 0;
+
+    while (s->hashes[idx] != 0) {
+        if (s->dist[idx] < d) {
+            uint64_t th = s->hashes[idx];
+            char *tkey = s->keys[idx];
+            void *tvalue = s->values[idx];
+            uint32_t td = s->dist[idx];
+
+            s->hashes[idx] = h;
+            s->keys[idx] = key;
+            s->values[idx] = value;
+            s->dist[idx] = d;
+            if (placed < 0) {
+                placed = idx;
+            }
+            h = th;
+            key = tkey;
+            value = tvalue;
+            d = td;
+        }
+        if (++idx == s->max) {
+            idx = 0;
+        }
+        d++;
+    }
+    s->hashes[idx] = h;
+    s->keys[idx] = key;
+    s->values[idx] = value;
+    s->dist[idx] = d;
+    return placed < 0 ? idx : placed;
+}
+
+// Clear slot hole and shift the rest of the chain back one slot, up to
+// the first free slot or entry in its home slot.
+static void robin_erase(struct slots *s, int hole) {
+    int idx = hole;
+
+    for (;;) {
+        if (++idx == s->max) {
+            idx = 0;
+        }
+        if (s->hashes[idx] == 0 || s->dist[idx] == 0) {
+            break;
+        }
+        s->hashes[hole] = s->hashes[idx];
+        s->keys[hole] = s->keys[idx];
+        s->values[hole] = s->values[idx];
+        s->dist[hole] = s->dist[idx] - 1;
+        hole = idx;
+    }
+    s->hashes[hole] = 0;
+    s->keys[hole] = NULL;
+    s->values[hole] = NULL;
+    s->dist[hole] = 0;
+}
+
+// ===========SWISS GROUP PROBING============
+
+/*
+ * Bit i of the result is set if control byte i of the group starting
+ * at g equals c. One SSE2 compare covers the whole group.
+ */
+static inline unsigned group_match(const uint8_t *g, uint8_t c) {
+#ifdef __SSE2__
+    __m128i ctrl = _mm_loadu_si128((const __m128i *)g);
+    return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl,
+                                                      _mm_set1_epi8((char)c)));
+#else
+    unsigned mask = 0;
+    for (int i = 0; i < GROUP_WIDTH; i++) {
+        mask |= (unsigned)(g[i] == c) << i;
+    }
+    return mask;
+#endif
+}
+
+// Bit i of the result is set if slot i of the group is empty or deleted.
+static inline unsigned group_match_free(const uint8_t *g) {
+#ifdef __SSE2__
+    return (unsigned)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)g));
+#else
+    unsigned mask = 0;
+    for (int i = 0; i < GROUP_WIDTH; i++) {
+        mask |= (unsigned)(g[i] >> 7) << i;
+    }
+    return mask;
+#endif
+}
+
+// Set a control byte. The first group is mirrored after the last slot
+// so that a group starting near the end can be loaded in one go.
+static inline void set_ctrl(struct slots *s, int idx, uint8_t c) {
+    s->ctrl[idx] = c;
+    if (idx < GROUP_WIDTH) {
+        s->ctrl[s->max + idx] = c;
+    }
+}
+
+/*
+ * Find the slot holding key. Probes whole groups, stepping by growing
+ * multiples of the group width, until a group with an empty slot.
+ * Returns -1 if the key is missing.
+ */
+static int swiss_find(const struct slots *s, const char *key, uint64_t h) {
+    int mask = s->max - 1;
+    int pos = group_slot(h, s->max);
+
+    for (int step = GROUP_WIDTH; ; step += GROUP_WIDTH) {
+        const uint8_t *g = s->ctrl + pos;
+        for (unsigned m = group_match(g, h & 0x7f); m != 0; m &= m - 1) {
+            int idx = (pos + __builtin_ctz(m)) & mask;
+            if (s->hashes[idx] == h && strcmp(s->keys[idx], key) == 0) {
+                return idx;
+            }
+        }
+        if (group_match(g, CTRL_EMPTY) != 0) {
+            return -1;
+        }
+        pos = (pos + step) & mask;
+    }
+}
+
+// Claim the first empty or deleted slot on the probe sequence of h.
+static int swiss_claim(struct slots *s, uint64_t h) {
+    int mask = s->max - 1;
+    int pos = group_slot(h, s->max);
+    unsigned m;
+
+    for (int step = GROUP_WIDTH;
+         (m = group_match_free(s->ctrl + pos)) == 0; step += GROUP_WIDTH) {
+        pos = (pos + step) & mask;
+    }
+    int idx = (pos + __builtin_ctz(m)) & mask;
+    if (s->ctrl[idx] == CTRL_DELETED) {
+        s->tombstones--;
+    }
+    set_ctrl(s, idx, h & 0x7f);
+    return idx;
+}
+
+/*
+ * Free slot idx. Probing only passes a slot if every group over it is
+ * full. If the run of non-empty slots around idx is shorter than a
+ * group, no probe ever passed it and it can be marked empty. Otherwise
+ * it becomes a tombstone.
+ */
+static void swiss_erase(struct slots *s, int idx) {
+    int before = (idx - GROUP_WIDTH) & (s->max - 1);
+    unsigned empty_before = group_match(s->ctrl + before, CTRL_EMPTY);
+    unsigned empty_after = group_match(s->ctrl + idx, CTRL_EMPTY);
+    bool never_full = empty_before != 0 && empty_after != 0
+        && __builtin_clz(empty_before) - (32 - GROUP_WIDTH)
+           + __builtin_ctz(empty_after) < GROUP_WIDTH;
+
+    if (never_full) {
+        set_ctrl(s, idx, CTRL_EMPTY);
+    } else {
+        set_ctrl(s, idx, CTRL_DELETED);
+        s->tombstones++;
+    }
+    s->hashes[idx] = 0;
+    s->keys[idx] = NULL;
+    s->values[idx] = NULL;
+}
+
+// ===========LAYOUT DISPATCH============
+
+// Find the slot holding key in s, or -1.
+static int slot_find(const hashtable *tbl, const struct slots *s,
+                     const char *key, uint64_t h) {
+    switch (tbl->layout) {
+    case HASHTABLE_SWISS:
+        return swiss_find(s, key, h);
+    case HASHTABLE_ROBIN_HOOD:
+        return robin_find(s, key, h);
+    default:
+        return probe_find(s, home_slot(h, s->max), key, h);
+    }
+}
+
+// Store an entry in a free slot of s. Returns the slot index.
+static int slot_store(const hashtable *tbl, struct slots *s, uint64_t h,
+                      char *key, void *value) {
+    int idx;
+
+    switch (tbl->layout) {
+    case HASHTABLE_SWISS:
+        idx = swiss_claim(s, h);
+        break;
+    case HASHTABLE_ROBIN_HOOD:
+        return robin_store(s, h, key, value);
+    default:
+        idx = probe_free(s, home_slot(h, s->max));
+        break;
+    }
+    s->hashes[idx] = h;
+    s->keys[idx] = key;
+    s->values[idx] = value;
+    return idx;
+}
+
+// Remove the entry in slot idx of s.
+static void slot_erase(const hashtable *tbl, struct slots *s, int idx) {
+    switch (tbl->layout) {
+    case HASHTABLE_SWISS:
+        swiss_erase(s, idx);
+        break;
+    case HASHTABLE_ROBIN_HOOD:
+        robin_erase(s, idx);
+        break;
+    default:
+        backward_shift(s, idx);
+        break;
+    }
+}
+
+/*
+ * Probe sequence length of the entry in slot idx: the number of slots,
+ * or groups in the swiss layout, probed past its first one.
+ */
+static int slot_psl(const hashtable *tbl, const struct slots *s, int idx) {
+    uint64_t h = s->hashes[idx];
+
+    switch (tbl->layout) {
+    case HASHTABLE_SWISS: {
+        int mask = s->max - 1;
+        int pos = group_slot(h, s->max);
+        int psl = 0;
+        while (((idx - pos) & mask) >= GROUP_WIDTH) {
+            psl++;
+            pos = (pos + psl * GROUP_WIDTH) & mask;
+        }
+        return psl;
+    }
+    case HASHTABLE_ROBIN_HOOD:
+        return s->dist[idx];
+    default:
+        return cyclic_dist(home_slot(h, s->max), idx, s->max);
+    }
+}
+
+/*
+ * Prefetch the slot data a probe for h in s reads first: the home slot's
+ * hash and key, or the first group's control bytes and hash.
+ */
+static inline void slot_prefetch(const hashtable *tbl, const struct slots *s,
+                                 uint64_t h) {
+    int idx;
+
+    switch (tbl->layout) {
+    case HASHTABLE_SWISS:
+        idx = group_slot(h, s->max);
+        __builtin_prefetch(s->ctrl + idx);
+        __builtin_prefetch(&s->hashes[idx]);
+        break;
+    case HASHTABLE_ROBIN_HOOD:
+        idx = home_slot(h, s->max);
+        __builtin_prefetch(&s->dist[idx]);
+        __builtin_prefetch(&s->hashes[idx]);
+        __builtin_prefetch(&s->keys[idx]);
+        break;
+    default:
+        idx = home_slot(h, s->max);
+        __builtin_prefetch(&s->hashes[idx]);
+        __builtin_prefetch(&s->keys[idx]);
+        break;
+    }
+}
+
+/*
+ * Prefetch the bytes of the key stored in the slot a probe for h reads
+ * first, if its hash matches. Reads the lines slot_prefetch() asked for,
+ * so it runs once the whole batch has been through slot_prefetch().
+ */
+static inline void key_prefetch(const hashtable *tbl, const struct slots *s,
+                                uint64_t h) {
+    int idx = tbl->layout == HASHTABLE_SWISS ? group_slot(h, s->max)
+                                             : home_slot(h, s->max);
+
+    if (s->hashes[idx] == h) {
+        __builtin_prefetch(s->keys[idx]);
+    }
+}
+
+// ===========RESIZING============
+
+// Move the key in old slot idx into the current slots.
+static int migrate_key(hashtable *tbl, int idx) {
+    uint64_t h = tbl->old.hashes[idx];
+    char *key = tbl->old.keys[idx];
+    void *value = tbl->old.values[idx];
+
+    slot_erase(tbl, &tbl->old, idx);
+    return slot_store(tbl, &tbl->cur, h, key, value);
+}
+
+/*
+ * Migrate up to n of the old slots, in order from old_start. Migrated
+ * slots are left empty. Erasing pulls the rest of a chain back into
+ * the slot, so once it is empty no chain of an unmigrated key runs
+ * through it and lookups in the old slots probe as usual. Frees the
+ * old slots when the last one has been migrated.
+ */
+static void migrate_step(hashtable *tbl, int n) {
+    while (n-- > 0 && tbl->migrated < tbl->old.max) {
+        int idx = (tbl->old_start + tbl->migrated) % tbl->old.max;
+        // A backward shift may refill the slot, so only advance past
+        // it once it is free.
+        while (tbl->old.hashes[idx] != 0) {
+            migrate_key(tbl, idx);
+        }
+        tbl->migrated++;
+    }
+    if (tbl->migrated == tbl->old.max) {
+        slots_free(&tbl->old);
+    }
+}
+
+/*
+ * Find the slot holding key in the current or, while migrating, the
+ * old slots. Sets *s to the slots it was found in. Returns the slot
+ * index, or -1 if the key is missing.
+ */
+static int find_key(hashtable *tbl, const char *key, uint64_t h,
+                    struct slots **s) {
+    *s = &tbl->cur;
+    int idx = slot_find(tbl, &tbl->cur, key, h);
+
+    if (idx < 0 && tbl->old.hashes != NULL) {
+        *s = &tbl->old;
+        idx = slot_find(tbl, &tbl->old, key, h);
+    }
+    return idx;
+}
+
+/*
+ * Copy the stored keys into one fresh chunk, dropping the space of
+ * removed ones. Only done right after a full rehash, which already
+ * costs O(size), and skipped if the chunk cannot be allocated. Needs
+ * all keys in the current slots.
+ */
+static void arena_compact(hashtable *tbl) {
+    struct key_arena fresh = { 0 };
+    struct slots *s = &tbl->cur;
+
+    if (arena_grow(&fresh, tbl->arena.live) < 0) {
+        return;
+    }
+    for (int idx = 0; idx < s->max; idx++) {
+        if (s->hashes[idx] != 0) {
+            struct arena_key *k = arena_key_of(s->keys[idx]);
+            s->keys[idx] = arena_store(&fresh, k->str, k->len, k->hash);
+        }
+    }
+    arena_free(&tbl->arena);
+    tbl->arena = fresh;
+}
+
+/*
+ * Move to a new slot array of max slots. The keys are moved to the
+ * new slots at once, or a few slots per insert in incremental mode.
+ */
+static int hashtable_resize(hashtable *tbl, int max) {
+    struct slots grown;
+
+    if (tbl->old.hashes != NULL) {
+        migrate_step(tbl, tbl->old.max);
+    }
+    if (slots_init(&grown, max, tbl->layout) < 0) {
+        return -1;
+    }
+    tbl->old = tbl->cur;
+    tbl->cur = grown;
+    STAT_ADD(tbl, resizes, 1);
+
+    // Start right after a free slot. No probe chain runs across it,
+    // so no chain of an unmigrated key passes through migrated slots.
+    int idx = probe_free(&tbl->old, 0);
+    tbl->old_start = (idx + 1) % tbl->old.max;
+    tbl->migrated = 0;
+
+    if (!tbl->incremental) {
+        migrate_step(tbl, tbl->old.max);
+        if (tbl->copy_keys && tbl->arena.dead > tbl->arena.live) {
+            arena_compact(tbl);
+        }
+    }
+    return 0;
+}
+
+// Add a key known to be missing. Returns its slot, or -1 if out of memory.
+static int insert_new(hashtable *tbl, char *key, uint64_t h, void *value) {
+    int max = tbl->cur.max;
+
+    // Tombstones lengthen probes like keys do, so they count as load.
+    if (tbl->size + tbl->cur.tombstones + 1 > tbl->max_load * max) {
+        // Double, unless most of the load is tombstones. Then rebuild
+        // at the same size to drop them.
+        if (tbl->size + 1 > tbl->max_load * max / 2) {
+            max *= 2;
+        }
+        if (hashtable_resize(tbl, max) < 0) {
+            return -1;
+        }
+    } else if (tbl->old.hashes != NULL) {
+        migrate_step(tbl, HASHTABLE_MIGRATE_STEP);
+    }
+    if (tbl->copy_keys) {
+        key = arena_store(&tbl->arena, key, strlen(key), h);
+        if (key == NULL) {
+            return -1;
+        }
+    }
+
+    int idx = slot_store(tbl, &tbl->cur, h, key, value);
+    tbl->size++;
+    return idx;
+}
+
+hashtable *hashtable_create(const hashtable_config *cfg) {
+    hashtable_config defaults = { 0 };
+    if (cfg == NULL) {
+        cfg = &defaults;
+    }
 
     struct hashtable *tbl = calloc(1, sizeof(*tbl));
-    tbl->arr = arr;
-    tbl->max = max;
+    if (tbl == NULL) {
+        return NULL;
+    }
+    int max = cfg->capacity > 0 ? cfg->capacity : HASHTABLE_MIN_CAPACITY;
+    if (max < HASHTABLE_MIN_CAPACITY) {
+        max = HASHTABLE_MIN_CAPACITY;
+    }
+    // Group probing masks the hash, so it needs a power of two.
+    if (cfg->layout == HASHTABLE_SWISS) {
+        int pow2 = GROUP_WIDTH;
+        while (pow2 < max) {
+            pow2 *= 2;
+        }
+        max = pow2;
+    }
+    tbl->layout = cfg->layout;
+    if (slots_init(&tbl->cur, max, tbl->layout) < 0) {
+        free(tbl);
+        return NULL;
+    }
+    tbl->hash_func = cfg->hash_func ? cfg->hash_func : hashtable_hash_bytes;
+    tbl->seed = cfg->seed ? cfg->seed : hashtable_random_seed(tbl);
+    tbl->max_load = cfg->max_load > 0 && cfg->max_load < 1
+        ? cfg->max_load : HASHTABLE_MAX_LOAD;
+    tbl->incremental = cfg->incremental;
+    tbl->copy_keys = cfg->copy_keys;
 
     return tbl;
 }
+
+hashtable* hashtable_empty(int max) {
+    hashtable_config cfg = { .capacity = max };
+
+    return hashtable_create(&cfg);
+}
+
 int hashtable_hash(hashtable *tbl, char *key) {
-    int asc_sum = 0;
-    for(int i = 0; i < strlen(key); i++) {
-        asc_sum += key[i];
+    uint64_t h = key_hash(tbl, key);
+
+    if (tbl->layout == HASHTABLE_SWISS) {
+        return group_slot(h, tbl->cur.max);
     }
-    return tbl->max % asc_sum;
+    return home_slot(h, tbl->cur.max);
 }
 
 hashtable* hashtable_insert(hashtable* tbl, char *key) {
-    int idx = hashtable_hash(tbl, key);
+    uint64_t h = key_hash(tbl, key);
+    struct slots *s;
+
+    if (find_key(tbl, key, h, &s) < 0 && insert_new(tbl, key, h, NULL) < 0) {
+        return NULL;
+    }
+    return  tbl;
+}
+
+hashtable *hashtable_put(hashtable *tbl, char *key, void *value) {
+    uint64_t h = key_hash(tbl, key);
+    struct slots *s;
+    int idx = find_key(tbl, key, h, &s);
+
+    if (idx >= 0) {
+        s->values[idx] = value;
+    } else if (insert_new(tbl, key, h, value) < 0) {
+        return NULL;
+    }
+    return tbl;
+}
+
+void *hashtable_get(hashtable *tbl, const char *key) {
+    struct slots *s;
+    int idx = find_key(tbl, key, key_hash(tbl, key), &s);
+
+    if (idx < 0) {
+        STAT_ADD(tbl, misses, 1);
+        return NULL;
+    }
+    STAT_ADD(tbl, hits, 1);
+    return s->values[idx];
+}
+
+void *hashtable_get_or_insert(hashtable *tbl, char *key, void *value) {
+    uint64_t h = key_hash(tbl, key);
+    struct slots *s;
+    int idx = find_key(tbl, key, h, &s);
+
+    if (idx >= 0) {
+        return s->values[idx];
+    }
+    return insert_new(tbl, key, h, value) >= 0 ? value : NULL;
+}
 
-    if(!array_1d_has_key(tbl->arr, idx)) {
-        array_1d_set_key(tbl->arr, key, idx);
+hashtable *hashtable_remove(hashtable *tbl, char *key) {
+    struct slots *s;
+    int idx = find_key(tbl, key, key_hash(tbl, key), &s);
+
+    if (idx >= 0) {
+        if (tbl->copy_keys) {
+            arena_release(&tbl->arena, s->keys[idx]);
+        }
+        slot_erase(tbl, s, idx);
+        tbl->size--;
+    }
+    return tbl;
+}
+
+int hashtable_lookup(hashtable *tbl, char *key) {
+    uint64_t h = key_hash(tbl, key);
+    struct slots *s;
+    int idx = find_key(tbl, key, h, &s);
+
+    if (idx < 0) {
+        STAT_ADD(tbl, misses, 1);
     } else {
-        while(array_1d_has_key(tbl->arr, idx) && idx < tbl->max) {
-            idx++;
+        STAT_ADD(tbl, hits, 1);
+    }
+    if (idx >= 0 && s == &tbl->old) {
+        // Not migrated yet. Move it over so the index refers to the
+        // current slots.
+        idx = migrate_key(tbl, idx);
+    }
+    return idx;
+}
+
+// ===========BATCHES============
+
+/*
+ * Hash up to HASHTABLE_BATCH keys into h and prefetch their first
+ * probe, then the stored keys their hashes match. Returns the number
+ * of keys taken. Only the current slots are prefetched; keys still in
+ * the old slots are probed cold.
+ */
+static int batch_prefetch(const hashtable *tbl, char **keys, int n,
+                          uint64_t *h) {
+    if (n > HASHTABLE_BATCH) {
+        n = HASHTABLE_BATCH;
+    }
+    for (int i = 0; i < n; i++) {
+        h[i] = key_hash(tbl, keys[i]);
+        slot_prefetch(tbl, &tbl->cur, h[i]);
+    }
+    for (int i = 0; i < n; i++) {
+        key_prefetch(tbl, &tbl->cur, h[i]);
+    }
+    return n;
+}
+
+int hashtable_lookup_many(hashtable *tbl, char **keys, int n, void **values) {
+    uint64_t h[HASHTABLE_BATCH];
+    int found = 0;
+
+    for (int start = 0; start < n; ) {
+        int m = batch_prefetch(tbl, keys + start, n - start, h);
+        for (int i = 0; i < m; i++) {
+            struct slots *s;
+            int idx = find_key(tbl, keys[start + i], h[i], &s);
+            values[start + i] = idx >= 0 ? s->values[idx] : NULL;
+            found += idx >= 0;
         }
-        if(idx == tbl->max) {
-            printf("Could not insert that key! Probably issue with clustering.\n");
-        } else {
-            array_1d_set_key(tbl->arr, key, idx);
+        start += m;
+    }
+    STAT_ADD(tbl, hits, found);
+    STAT_ADD(tbl, misses, n - found);
+    return found;
+}
+
+hashtable *hashtable_insert_many(hashtable *tbl, char **keys, void **values,
+                                 int n) {
+    uint64_t h[HASHTABLE_BATCH];
+
+    for (int start = 0; start < n; ) {
+        int m = batch_prefetch(tbl, keys + start, n - start, h);
+        for (int i = 0; i < m; i++) {
+            char *key = keys[start + i];
+            void *value = values != NULL ? values[start + i] : NULL;
+            struct slots *s;
+            int idx = find_key(tbl, key, h[i], &s);
+            if (idx >= 0) {
+                s->values[idx] = value;
+            } else if (insert_new(tbl, key, h[i], value) < 0) {
+                return NULL;
+            }
         }
+        start += m;
     }
+    return tbl;
+}
 
-    return  tbl;
+// ===========BULK BUILD============
+
+/*
+ * A partitioned build of the linear layout. The slots are split into
+ * parts contiguous ranges and each key belongs to the part holding its
+ * home slot. Keys are first grouped by part, keeping their input order,
+ * then each part is filled by its own thread. A thread only writes the
+ * slots of its part, so the threads need no locking.
+ */
+struct build {
+    hashtable *tbl;
+    char **keys;
+    void **values;
+    int n;
+    int parts;
+    uint64_t *h;        // Hash of each key.
+    int *count;         // count[t * parts + p]: keys of chunk t in part p.
+    int *first;         // Keys of part p are order[first[p]..first[p + 1]).
+    int *order;         // Key indices grouped by part.
+    int *overflow;      // Keys that ran past their part, per part from
+                        // first[p].
+    int *n_overflow;    // Number of overflow keys of each part.
+    int *placed;        // Number of new keys stored in each part.
+};
+
+struct build_task {
+    struct build *b;
+    int t;
+    void (*fn)(struct build *b, int t);
+};
+
+// Part holding slot idx.
+static inline int build_part(const struct build *b, int idx) {
+    return (int)((uint64_t)idx * b->parts / b->tbl->cur.max);
 }
 
-int hashtable_lookup(hashtable *tbl, char *key) {
-    int idx = hashtable_hash(tbl, key);
+// First slot of part p, or the slot count for p == parts.
+static inline int build_part_start(const struct build *b, int p) {
+    return (int)(((uint64_t)p * b->tbl->cur.max + b->parts - 1) / b->parts);
+}
 
-    if(array_1d_inspect_key(tbl->arr, idx) == key) {
-        return idx;
-    } else {
-        while(array_1d_inspect_key(tbl->arr, idx) != key && idx < tbl->max) {
+// Key indices of chunk t in the hashing and grouping passes.
+static inline int build_chunk_start(const struct build *b, int t) {
+    return (int)((int64_t)t * b->n / b->parts);
+}
+
+// Hash the keys of chunk t and count them per part.
+static void build_hash(struct build *b, int t) {
+    int *count = b->count + (size_t)t * b->parts;
+
+    for (int i = build_chunk_start(b, t); i < build_chunk_start(b, t + 1);
+         i++) {
+        b->h[i] = key_hash(b->tbl, b->keys[i]);
+        count[build_part(b, home_slot(b->h[i], b->tbl->cur.max))]++;
+    }
+}
+
+// Write the keys of chunk t to their part of order. count holds the
+// position of the chunk's first key in each part.
+static void build_group(struct build *b, int t) {
+    int *pos = b->count + (size_t)t * b->parts;
+
+    for (int i = build_chunk_start(b, t); i < build_chunk_start(b, t + 1);
+         i++) {
+        b->order[pos[build_part(b, home_slot(b->h[i], b->tbl->cur.max))]++]
+            = i;
+    }
+}
+
+// Place the keys of part p within its slots. A key whose probe reaches
+// the end of the part is left for build_overflow().
+static void build_place(struct build *b, int p) {
+    struct slots *s = &b->tbl->cur;
+    int end = build_part_start(b, p + 1);
+
+    for (int j = b->first[p]; j < b->first[p + 1]; j++) {
+        if (j + HASHTABLE_BATCH < b->first[p + 1]) {
+            slot_prefetch(b->tbl, s, b->h[b->order[j + HASHTABLE_BATCH]]);
+        }
+        int i = b->order[j];
+        uint64_t h = b->h[i];
+        int idx = home_slot(h, s->max);
+        while (idx < end && s->hashes[idx] != 0
+               && (s->hashes[idx] != h || strcmp(s->keys[idx], b->keys[i]))) {
             idx++;
         }
-        if(idx == tbl->max) {
-            return -1;        
+        if (idx == end) {
+            b->overflow[b->first[p] + b->n_overflow[p]++] = i;
+            continue;
+        }
+        if (s->hashes[idx] == 0) {
+            s->hashes[idx] = h;
+            s->keys[idx] = b->keys[i];
+            b->placed[p]++;
+        }
+        s->values[idx] = b->values != NULL ? b->values[i] : NULL;
+    }
+}
+
+// Place the keys that ran past their part, probing the whole table.
+static void build_overflow(struct build *b) {
+    hashtable *tbl = b->tbl;
+
+    for (int p = 0; p < b->parts; p++) {
+        for (int j = 0; j < b->n_overflow[p]; j++) {
+            int i = b->overflow[b->first[p] + j];
+            void *value = b->values != NULL ? b->values[i] : NULL;
+            int idx = probe_find(&tbl->cur, home_slot(b->h[i], tbl->cur.max),
+                                 b->keys[i], b->h[i]);
+            if (idx >= 0) {
+                tbl->cur.values[idx] = value;
+            } else {
+                slot_store(tbl, &tbl->cur, b->h[i], b->keys[i], value);
+                tbl->size++;
+            }
+        }
+    }
+}
+
+static void *build_thread(void *arg) {
+    struct build_task *task = arg;
+
+    task->fn(task->b, task->t);
+    return NULL;
+}
+
+// Run fn(b, t) for each part t, part 0 in the calling thread. A part
+// whose thread cannot be started is run after the others are joined.
+static void build_run(struct build *b, void (*fn)(struct build *, int)) {
+    struct build_task task[BUILD_MAX_THREADS];
+    pthread_t tid[BUILD_MAX_THREADS];
+    bool started[BUILD_MAX_THREADS];
+
+    for (int t = 1; t < b->parts; t++) {
+        task[t] = (struct build_task){ .b = b, .t = t, .fn = fn };
+        started[t] = pthread_create(&tid[t], NULL, build_thread,
+                                    &task[t]) == 0;
+    }
+    fn(b, 0);
+    for (int t = 1; t < b->parts; t++) {
+        if (started[t]) {
+            pthread_join(tid[t], NULL);
         } else {
-            return idx;
+            fn(b, t);
+        }
+    }
+}
+
+// Allocate the work arrays of b and place its keys in parallel.
+// Returns -1 if an allocation failed. The arrays are freed by the
+// caller either way.
+static int build_parts(struct build *b) {
+    int parts = b->parts;
+
+    b->h = malloc((size_t)b->n * sizeof(*b->h));
+    b->count = calloc((size_t)parts * parts, sizeof(*b->count));
+    b->first = malloc((parts + 1) * sizeof(*b->first));
+    b->order = malloc((size_t)b->n * sizeof(*b->order));
+    b->overflow = malloc((size_t)b->n * sizeof(*b->overflow));
+    b->n_overflow = calloc(parts, sizeof(*b->n_overflow));
+    b->placed = calloc(parts, sizeof(*b->placed));
+    if (b->h == NULL || b->count == NULL || b->first == NULL
+        || b->order == NULL || b->overflow == NULL || b->n_overflow == NULL
+        || b->placed == NULL) {
+        return -1;
+    }
+
+    build_run(b, build_hash);
+    // Turn the counts into the position of each chunk's first key in
+    // each part. Chunks follow each other within a part, so the keys of
+    // a part keep their input order.
+    int pos = 0;
+    for (int p = 0; p < parts; p++) {
+        b->first[p] = pos;
+        for (int t = 0; t < parts; t++) {
+            int c = b->count[(size_t)t * parts + p];
+            b->count[(size_t)t * parts + p] = pos;
+            pos += c;
+        }
+    }
+    b->first[parts] = pos;
+    build_run(b, build_group);
+    build_run(b, build_place);
+
+    for (int p = 0; p < parts; p++) {
+        b->tbl->size += b->placed[p];
+    }
+    build_overflow(b);
+    return 0;
+}
+
+// Build the linear layout of tbl, sized for the keys, from the keys.
+static int build_linear(hashtable *tbl, char **keys, void **values, int n,
+                        int threads) {
+    struct build b = {
+        .tbl = tbl,
+        .keys = keys,
+        .values = values,
+        .n = n,
+        .parts = threads,
+    };
+    int ret = build_parts(&b);
+
+    free(b.h);
+    free(b.count);
+    free(b.first);
+    free(b.order);
+    free(b.overflow);
+    free(b.n_overflow);
+    free(b.placed);
+    return ret;
+}
+
+hashtable *hashtable_build(const hashtable_config *cfg, char **keys,
+                           void **values, int n) {
+    hashtable_config sized = { 0 };
+    if (cfg != NULL) {
+        sized = *cfg;
+    }
+    double max_load = sized.max_load > 0 && sized.max_load < 1
+        ? sized.max_load : HASHTABLE_MAX_LOAD;
+    // Room for n keys without growing.
+    double needed = n / max_load + 1;
+    if (needed > INT_MAX / 2) {
+        return NULL;
+    }
+    if (sized.capacity < needed) {
+        sized.capacity = (int)needed;
+    }
+
+    hashtable *tbl = hashtable_create(&sized);
+    if (tbl == NULL) {
+        return NULL;
+    }
+    if (tbl->layout != HASHTABLE_LINEAR) {
+        if (hashtable_insert_many(tbl, keys, values, n) == NULL) {
+            hashtable_kill(tbl);
+            return NULL;
+        }
+        return tbl;
+    }
+
+    int threads = sized.build_threads;
+    if (threads > n / BUILD_MIN_KEYS) {
+        threads = n / BUILD_MIN_KEYS;
+    }
+    if (threads > BUILD_MAX_THREADS) {
+        threads = BUILD_MAX_THREADS;
+    }
+    if (threads < 1) {
+        threads = 1;
+    }
+    if (n == 0) {
+        // Nothing to place. The work arrays would be empty, and
+        // malloc(0) may return NULL.
+        return tbl;
+    }
+    if (build_linear(tbl, keys, values, n, threads) < 0) {
+        hashtable_kill(tbl);
+        return NULL;
+    }
+    if (tbl->copy_keys) {
+        // Copy the stored keys once they are placed. Duplicates are
+        // copied only once.
+        struct slots *s = &tbl->cur;
+        for (int idx = 0; idx < s->max; idx++) {
+            if (s->hashes[idx] == 0) {
+                continue;
+            }
+            s->keys[idx] = arena_store(&tbl->arena, s->keys[idx],
+                                       strlen(s->keys[idx]), s->hashes[idx]);
+            if (s->keys[idx] == NULL) {
+                hashtable_kill(tbl);
+                return NULL;
+            }
         }
     }
+    return tbl;
+}
+
+// ===========ITERATION============
+
+// Find the next used slot at or after the iterator's position, in the
+// current and then the old slots. Returns its slots, or NULL.
+static struct slots *iter_seek(hashtable_iter *it) {
+    hashtable *tbl = it->tbl;
+
+    for (;;) {
+        struct slots *s = it->old ? &tbl->old : &tbl->cur;
+        if (s->hashes != NULL) {
+            while (it->idx < s->max && s->hashes[it->idx] == 0) {
+                it->idx++;
+            }
+            if (it->idx < s->max) {
+                return s;
+            }
+        }
+        if (it->old) {
+            return NULL;
+        }
+        it->old = true;
+        it->idx = 0;
+    }
+}
+
+void hashtable_iter_begin(hashtable *tbl, hashtable_iter *it) {
+    it->tbl = tbl;
+    it->old = false;
+    it->idx = 0;
+}
+
+bool hashtable_iter_next(hashtable_iter *it, char **key, void **value) {
+    struct slots *s = iter_seek(it);
+
+    if (s == NULL) {
+        return false;
+    }
+    *key = s->keys[it->idx];
+    *value = s->values[it->idx];
+    it->idx++;
+    return true;
+}
+
+bool hashtable_iter_drain(hashtable_iter *it, char **key, void **value) {
+    struct slots *s = iter_seek(it);
+
+    if (s == NULL) {
+        return false;
+    }
+    *key = s->keys[it->idx];
+    *value = s->values[it->idx];
+    if (it->tbl->copy_keys) {
+        arena_release(&it->tbl->arena, *key);
+    }
+    // Erasing only moves later keys of the chain back into this slot,
+    // never into one already passed, so the position stays.
+    slot_erase(it->tbl, s, it->idx);
+    it->tbl->size--;
+    return true;
+}
+
+// Bytes held by a slot array.
+static size_t slots_bytes(const hashtable *tbl, const struct slots *s) {
+    size_t per_slot = sizeof(*s->hashes) + sizeof(*s->keys)
+        + sizeof(*s->values);
+
+    if (s->hashes == NULL) {
+        return 0;
+    }
+    if (tbl->layout == HASHTABLE_SWISS) {
+        return (size_t)s->max * (per_slot + 1) + GROUP_WIDTH;
+    }
+    if (tbl->layout == HASHTABLE_ROBIN_HOOD) {
+        per_slot += sizeof(*s->dist);
+    }
+    return (size_t)s->max * per_slot;
+}
 
+// Slot idx is taken, by a key or, in the swiss layout, a tombstone.
+static inline bool slot_taken(const struct slots *s, int idx) {
+    return s->hashes[idx] != 0
+        || (s->ctrl != NULL && s->ctrl[idx] == CTRL_DELETED);
+}
+
+// Longest run of taken slots. Starts after a free slot, so a run
+// wrapping around the end is counted in one piece.
+static int longest_cluster(const struct slots *s) {
+    int start = 0;
+    int run = 0, longest = 0;
+
+    while (start < s->max && slot_taken(s, start)) {
+        start++;
+    }
+    for (int i = 1; i <= s->max; i++) {
+        run = slot_taken(s, (start + i) % s->max) ? run + 1 : 0;
+        if (run > longest) {
+            longest = run;
+        }
+    }
+    return longest;
+}
+
+void hashtable_stats(const hashtable *tbl, struct hashtable_stats *out) {
+    const struct slots *gens[] = { &tbl->cur, &tbl->old };
+    long total = 0;
+
+    memset(out, 0, sizeof(*out));
+    out->size = tbl->size;
+    out->capacity = tbl->cur.max;
+    out->load = (double)tbl->size / tbl->cur.max;
+    out->bytes = sizeof(*tbl);
+    for (int g = 0; g < 2; g++) {
+        const struct slots *s = gens[g];
+        for (int idx = 0; s->hashes != NULL && idx < s->max; idx++) {
+            if (s->hashes[idx] != 0) {
+                int psl = slot_psl(tbl, s, idx);
+                total += psl;
+                if (psl > out->max_psl) {
+                    out->max_psl = psl;
+                }
+                out->psl_hist[psl < HASHTABLE_PSL_BUCKETS
+                              ? psl : HASHTABLE_PSL_BUCKETS - 1]++;
+            }
+        }
+        if (s->hashes != NULL) {
+            int cluster = longest_cluster(s);
+            if (cluster > out->max_cluster) {
+                out->max_cluster = cluster;
+            }
+        }
+        out->bytes += slots_bytes(tbl, s);
+    }
+    out->mean_psl = tbl->size > 0 ? (double)total / tbl->size : 0;
+    for (const struct arena_chunk *c = tbl->arena.head; c != NULL;
+         c = c->next) {
+        out->bytes += sizeof(*c) + c->size;
+    }
+#ifndef HASHTABLE_NO_STATS
+    out->hits = tbl->hits;
+    out->misses = tbl->misses;
+    out->resizes = tbl->resizes;
+#endif
 }
 
 void hashtable_kill(hashtable *tbl) {
-    array_1d_kill(tbl->arr);
+    arena_free(&tbl->arena);
+    slots_free(&tbl->old);
+    slots_free(&tbl->cur);
     free(tbl);
 }
 
+// ===========TABLE IMAGES============
+
+/*
+ * Layout of a table image file, all offsets from the start of the
+ * file. The header is followed by the slot array, at slots_off, and
+ * the key bytes, at keys_off. Each key is a uint32_t length followed by
+ * the bytes and a NUL, padded to 4 bytes. Slots are linear probed from
+ * hash & (capacity - 1), and a slot with hash 0 is free.
+ */
+struct image_header {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t slot_size;     // sizeof(struct image_slot).
+    uint64_t seed;          // Seed of the built-in hash.
+    uint64_t size;          // Number of keys.
+    uint64_t capacity;      // Number of slots, a power of two.
+    uint64_t slots_off;
+    uint64_t keys_off;
+    uint64_t file_size;
+    uint64_t checksum;      // Built-in hash, seed 0, of all after header.
+};
+
+struct image_slot {
+    uint64_t hash;
+    uint64_t key_off;
+    uint64_t value;
+};
+
+struct hashtable_image {
+    const uint8_t *map;
+    size_t len;
+    const struct image_header *hdr;
+    const struct image_slot *slots;
+};
+
+// Bytes taken by a key of len bytes in the key area.
+static inline size_t image_key_size(size_t len) {
+    return (sizeof(uint32_t) + len + 1 + 3) & ~(size_t)3;
+}
+
+static inline size_t image_align(size_t off) {
+    return (off + IMAGE_ALIGN - 1) & ~(size_t)(IMAGE_ALIGN - 1);
+}
+
+int hashtable_save(const hashtable *tbl, const char *path) {
+    const struct slots *gens[] = { &tbl->cur, &tbl->old };
+
+    if (tbl->hash_func != hashtable_hash_bytes) {
+        return -1;
+    }
+
+    // Size the image: at most half the slots in use.
+    uint64_t capacity = HASHTABLE_MIN_CAPACITY;
+    while (capacity < 2 * (uint64_t)tbl->size) {
+        capacity *= 2;
+    }
+    size_t keys_len = 0;
+    for (int g = 0; g < 2; g++) {
+        for (int idx = 0; gens[g]->hashes != NULL && idx < gens[g]->max;
+             idx++) {
+            if (gens[g]->hashes[idx] != 0) {
+                keys_len += image_key_size(strlen(gens[g]->keys[idx]));
+            }
+        }
+    }
+    size_t slots_off = image_align(sizeof(struct image_header));
+    size_t keys_off = image_align(slots_off
+                                  + capacity * sizeof(struct image_slot));
+    size_t file_size = keys_off + keys_len;
+    uint8_t *buf = calloc(1, file_size);
+    if (buf == NULL) {
+        return -1;
+    }
+
+    struct image_header *hdr = (struct image_header *)buf;
+    struct image_slot *slots = (struct image_slot *)(buf + slots_off);
+    size_t key_off = keys_off;
+    for (int g = 0; g < 2; g++) {
+        const struct slots *s = gens[g];
+        for (int idx = 0; s->hashes != NULL && idx < s->max; idx++) {
+            if (s->hashes[idx] == 0) {
+                continue;
+            }
+            uint64_t i = s->hashes[idx] & (capacity - 1);
+            while (slots[i].hash != 0) {
+                i = (i + 1) & (capacity - 1);
+            }
+            uint32_t len = (uint32_t)strlen(s->keys[idx]);
+            slots[i].hash = s->hashes[idx];
+            slots[i].key_off = key_off;
+            slots[i].value = (uint64_t)(uintptr_t)s->values[idx];
+            memcpy(buf + key_off, &len, sizeof(len));
+            memcpy(buf + key_off + sizeof(len), s->keys[idx], len);
+            key_off += image_key_size(len);
+        }
+    }
+    hdr->magic = IMAGE_MAGIC;
+    hdr->version = IMAGE_VERSION;
+    hdr->slot_size = sizeof(struct image_slot);
+    hdr->seed = tbl->seed;
+    hdr->size = tbl->size;
+    hdr->capacity = capacity;
+    hdr->slots_off = slots_off;
+    hdr->keys_off = keys_off;
+    hdr->file_size = file_size;
+    hdr->checksum = hashtable_hash_bytes(buf + sizeof(*hdr),
+                                         file_size - sizeof(*hdr), 0);
+
+    // Write a temporary file and rename it, so that readers mapping
+    // path never see a partly written image.
+    size_t tmp_len = strlen(path) + 5;
+    char *tmp = malloc(tmp_len);
+    FILE *f = NULL;
+    int status = -1;
+    if (tmp != NULL) {
+        snprintf(tmp, tmp_len, "%s.tmp", path);
+        f = fopen(tmp, "wb");
+    }
+    if (f != NULL) {
+        bool written = fwrite(buf, 1, file_size, f) == file_size;
+        if (fclose(f) == 0 && written && rename(tmp, path) == 0) {
+            status = 0;
+        } else {
+            remove(tmp);
+        }
+    }
+    free(tmp);
+    free(buf);
+    return status;
+}
+
+hashtable_image *hashtable_open_mmap(const char *path) {
+    int fd = open(path, O_RDONLY);
+    struct stat st;
+
+    if (fd < 0) {
+        return NULL;
+    }
+    if (fstat(fd, &st) < 0
+        || (size_t)st.st_size < sizeof(struct image_header)) {
+        close(fd);
+        return NULL;
+    }
+    void *map = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return NULL;
+    }
+
+    // Check everything lookups rely on, so that a damaged file cannot
+    // make them read outside the mapping.
+    const struct image_header *hdr = map;
+    size_t len = st.st_size;
+    bool valid = hdr->magic == IMAGE_MAGIC
+        && hdr->version == IMAGE_VERSION
+        && hdr->slot_size == sizeof(struct image_slot)
+        && hdr->file_size == len
+        && hdr->capacity > 0 && (hdr->capacity & (hdr->capacity - 1)) == 0
+        && hdr->size < hdr->capacity
+        && hdr->slots_off >= sizeof(*hdr) && hdr->slots_off % 8 == 0
+        && hdr->slots_off <= len
+        && hdr->capacity <= (len - hdr->slots_off) / sizeof(struct image_slot)
+        && hdr->keys_off <= len;
+    hashtable_image *img = valid ? malloc(sizeof(*img)) : NULL;
+    if (img == NULL) {
+        munmap(map, len);
+        return NULL;
+    }
+    img->map = map;
+    img->len = len;
+    img->hdr = hdr;
+    img->slots = (const struct image_slot *)(img->map + hdr->slots_off);
+    return img;
+}
+
+bool hashtable_image_get(const hashtable_image *img, const char *key,
+                         uint64_t *value) {
+    size_t len = strlen(key);
+    uint64_t h = hashtable_hash_bytes(key, len, img->hdr->seed);
+    uint64_t mask = img->hdr->capacity - 1;
+
+    h = h ? h : 1;
+    // A sound image has free slots. The bound on the walk keeps a
+    // damaged one from looping forever.
+    for (uint64_t i = h & mask, n = 0; n <= mask; i = (i + 1) & mask, n++) {
+        const struct image_slot *slot = &img->slots[i];
+        if (slot->hash == 0) {
+            return false;
+        }
+        if (slot->hash != h || slot->key_off > img->len - sizeof(uint32_t)) {
+            continue;
+        }
+        uint32_t klen;
+        memcpy(&klen, img->map + slot->key_off, sizeof(klen));
+        const uint8_t *bytes = img->map + slot->key_off + sizeof(klen);
+        if (klen == len && len <= img->len - slot->key_off - sizeof(klen)
+            && memcmp(bytes, key, len) == 0) {
+            if (value != NULL) {
+                *value = slot->value;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+int hashtable_image_size(const hashtable_image *img) {
+    return (int)img->hdr->size;
+}
+
+bool hashtable_image_verify(const hashtable_image *img) {
+    return hashtable_hash_bytes(img->map + sizeof(*img->hdr),
+                                img->len - sizeof(*img->hdr), 0)
+        == img->hdr->checksum;
+}
+
+void hashtable_image_close(hashtable_image *img) {
+    munmap((void *)img->map, img->len);
+    free(img);
+}
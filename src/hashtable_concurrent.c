@@ -0,0 +1,315 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <time.h>
+#include "hashtable.h"
+
+// Slot hashes with a special meaning. key_hash() maps real hashes
+// above them.
+#define HASH_FREE 0
+#define HASH_REMOVED 1
+
+// Default maximum load factor, counting removed slots.
+#define CONCURRENT_MAX_LOAD 0.75
+
+#define CACHE_LINE 64
+
+/*
+ * A slot. hash is stored last, with release ordering, so a reader that
+ * sees a hash also sees the key and value written before it. A slot
+ * holds one key for the lifetime of its slot array. Only the value
+ * changes, and removal only changes hash to HASH_REMOVED.
+ */
+struct cslot {
+    _Atomic uint64_t hash;
+    _Atomic(char *) key;
+    _Atomic(void *) value;
+};
+
+// A slot array. Built completely before it is published to readers.
+struct cslots {
+    size_t mask;            // Number of slots minus one.
+    struct cslots *retired; // Next replaced array of the shard.
+    struct cslot slot[];
+};
+
+// A key copy owned by the table. Linked into a list once removed.
+struct key_copy {
+    struct key_copy *next;
+    char str[];
+};
+
+struct shard {
+    _Alignas(CACHE_LINE) pthread_mutex_t lock;  // Held by writers.
+    _Atomic(struct cslots *) slots;
+    _Atomic int size;           // Number of keys.
+    int used;                   // Slots holding or having held a key.
+    struct cslots *retired;     // Arrays replaced by a grow.
+    struct key_copy *dead;      // Copies of removed keys.
+};
+
+struct hashtable_concurrent {
+    int nshards;
+    int shard_bits;             // log2(nshards).
+    double max_load;
+    hashtable_hash_func hash_func;
+    uint64_t seed;
+    struct shard *shards;
+};
+
+static inline uint64_t key_hash(const hashtable_concurrent *tbl,
+                                const char *key) {
+    uint64_t h = tbl->hash_func(key, strlen(key), tbl->seed);
+
+    return h > HASH_REMOVED ? h : h + 2;
+}
+
+// Shards take the top bits of the hash, slots the bottom ones.
+static inline struct shard *shard_of(const hashtable_concurrent *tbl,
+                                     uint64_t h) {
+    if (tbl->shard_bits == 0) {
+        return &tbl->shards[0];
+    }
+    return &tbl->shards[h >> (64 - tbl->shard_bits)];
+}
+
+static struct cslots *cslots_new(size_t n) {
+    struct cslots *s = calloc(1, sizeof(*s) + n * sizeof(s->slot[0]));
+
+    if (s != NULL) {
+        s->mask = n - 1;
+    }
+    return s;
+}
+
+static inline struct key_copy *copy_of(char *str) {
+    return (struct key_copy *)(str - offsetof(struct key_copy, str));
+}
+
+// Find the slot holding key. Returns -1 if the key is missing.
+static long slot_find(const struct cslots *s, const char *key, uint64_t h) {
+    for (size_t idx = h & s->mask; ; idx = (idx + 1) & s->mask) {
+        uint64_t sh = atomic_load_explicit(&s->slot[idx].hash,
+                                           memory_order_acquire);
+        if (sh == HASH_FREE) {
+            return -1;
+        }
+        if (sh == h) {
+            char *k = atomic_load_explicit(&s->slot[idx].key,
+                                           memory_order_relaxed);
+            if (strcmp(k, key) == 0) {
+                return (long)idx;
+            }
+        }
+    }
+}
+
+// Write an entry to the first free slot of its chain and publish it.
+static void slot_store(struct cslots *s, uint64_t h, char *key, void *value) {
+    size_t idx = h & s->mask;
+
+    while (atomic_load_explicit(&s->slot[idx].hash,
+                                memory_order_relaxed) != HASH_FREE) {
+        idx = (idx + 1) & s->mask;
+    }
+    atomic_store_explicit(&s->slot[idx].key, key, memory_order_relaxed);
+    atomic_store_explicit(&s->slot[idx].value, value, memory_order_relaxed);
+    atomic_store_explicit(&s->slot[idx].hash, h, memory_order_release);
+}
+
+/*
+ * Replace the slot array of a shard by one holding only its live keys,
+ * twice as large unless most used slots are removed ones. The old
+ * array is retired, as readers may still be probing it. Called with
+ * the shard lock held.
+ */
+static struct cslots *shard_rebuild(hashtable_concurrent *tbl,
+                                    struct shard *sh) {
+    struct cslots *old = atomic_load_explicit(&sh->slots,
+                                              memory_order_relaxed);
+    size_t n = old->mask + 1;
+    int size = atomic_load_explicit(&sh->size, memory_order_relaxed);
+
+    if (size + 1 > tbl->max_load * n / 2) {
+        n *= 2;
+    }
+    struct cslots *s = cslots_new(n);
+    if (s == NULL) {
+        return NULL;
+    }
+    for (size_t idx = 0; idx <= old->mask; idx++) {
+        uint64_t h = atomic_load_explicit(&old->slot[idx].hash,
+                                          memory_order_relaxed);
+        if (h > HASH_REMOVED) {
+            slot_store(s, h,
+                       atomic_load_explicit(&old->slot[idx].key,
+                                            memory_order_relaxed),
+                       atomic_load_explicit(&old->slot[idx].value,
+                                            memory_order_relaxed));
+        }
+    }
+    atomic_store_explicit(&sh->slots, s, memory_order_release);
+    old->retired = sh->retired;
+    sh->retired = old;
+    sh->used = size;
+    return s;
+}
+
+hashtable_concurrent *hashtable_concurrent_create(int shards,
+                                                  const hashtable_config *cfg) {
+    hashtable_config defaults = { 0 };
+    if (cfg == NULL) {
+        cfg = &defaults;
+    }
+
+    hashtable_concurrent *tbl = calloc(1, sizeof(*tbl));
+    if (tbl == NULL) {
+        return NULL;
+    }
+    tbl->nshards = 1;
+    while (tbl->nshards < shards) {
+        tbl->nshards *= 2;
+        tbl->shard_bits++;
+    }
+    tbl->max_load = cfg->max_load > 0 && cfg->max_load < 1
+        ? cfg->max_load : CONCURRENT_MAX_LOAD;
+    tbl->hash_func = cfg->hash_func ? cfg->hash_func : hashtable_hash_bytes;
+    tbl->seed = cfg->seed;
+    if (tbl->seed == 0) {
+        uint64_t salt = (uint64_t)(uintptr_t)tbl ^ (uint64_t)clock();
+        tbl->seed = hashtable_hash_bytes(&salt, sizeof(salt),
+                                         (uint64_t)time(NULL)) | 1;
+    }
+
+    size_t n = HASHTABLE_MIN_CAPACITY;
+    while (n < (size_t)cfg->capacity) {
+        n *= 2;
+    }
+    tbl->shards = aligned_alloc(CACHE_LINE,
+                                tbl->nshards * sizeof(*tbl->shards));
+    if (tbl->shards == NULL) {
+        free(tbl);
+        return NULL;
+    }
+    memset(tbl->shards, 0, tbl->nshards * sizeof(*tbl->shards));
+    for (int i = 0; i < tbl->nshards; i++) {
+        struct shard *sh = &tbl->shards[i];
+        pthread_mutex_init(&sh->lock, NULL);
+        atomic_init(&sh->size, 0);
+        atomic_init(&sh->slots, cslots_new(n));
+        if (atomic_load(&sh->slots) == NULL) {
+            tbl->nshards = i + 1;
+            hashtable_concurrent_kill(tbl);
+            return NULL;
+        }
+    }
+    return tbl;
+}
+
+int hashtable_concurrent_put(hashtable_concurrent *tbl, const char *key,
+                             void *value) {
+    uint64_t h = key_hash(tbl, key);
+    struct shard *sh = shard_of(tbl, h);
+    int status = 0;
+
+    pthread_mutex_lock(&sh->lock);
+    struct cslots *s = atomic_load_explicit(&sh->slots, memory_order_relaxed);
+    long idx = slot_find(s, key, h);
+    if (idx >= 0) {
+        atomic_store_explicit(&s->slot[idx].value, value,
+                              memory_order_release);
+    } else {
+        size_t len = strlen(key);
+        struct key_copy *copy = malloc(sizeof(*copy) + len + 1);
+        if (copy != NULL && sh->used + 1 > tbl->max_load * (s->mask + 1)) {
+            s = shard_rebuild(tbl, sh);
+        }
+        if (copy == NULL || s == NULL) {
+            free(copy);
+            status = -1;
+        } else {
+            memcpy(copy->str, key, len + 1);
+            slot_store(s, h, copy->str, value);
+            sh->used++;
+            atomic_fetch_add_explicit(&sh->size, 1, memory_order_relaxed);
+        }
+    }
+    pthread_mutex_unlock(&sh->lock);
+    return status;
+}
+
+void *hashtable_concurrent_get(hashtable_concurrent *tbl, const char *key) {
+    uint64_t h = key_hash(tbl, key);
+    struct shard *sh = shard_of(tbl, h);
+    struct cslots *s = atomic_load_explicit(&sh->slots, memory_order_acquire);
+    long idx = slot_find(s, key, h);
+
+    if (idx < 0) {
+        return NULL;
+    }
+    return atomic_load_explicit(&s->slot[idx].value, memory_order_acquire);
+}
+
+void hashtable_concurrent_remove(hashtable_concurrent *tbl, const char *key) {
+    uint64_t h = key_hash(tbl, key);
+    struct shard *sh = shard_of(tbl, h);
+
+    pthread_mutex_lock(&sh->lock);
+    struct cslots *s = atomic_load_explicit(&sh->slots, memory_order_relaxed);
+    long idx = slot_find(s, key, h);
+    if (idx >= 0) {
+        // Readers that already matched the hash may still compare the
+        // key, so its copy is only freed on reclaim.
+        struct key_copy *copy = copy_of(atomic_load_explicit(
+            &s->slot[idx].key, memory_order_relaxed));
+        atomic_store_explicit(&s->slot[idx].hash, HASH_REMOVED,
+                              memory_order_release);
+        copy->next = sh->dead;
+        sh->dead = copy;
+        atomic_fetch_sub_explicit(&sh->size, 1, memory_order_relaxed);
+    }
+    pthread_mutex_unlock(&sh->lock);
+}
+
+int hashtable_concurrent_size(hashtable_concurrent *tbl) {
+    int size = 0;
+
+    for (int i = 0; i < tbl->nshards; i++) {
+        size += atomic_load_explicit(&tbl->shards[i].size,
+                                     memory_order_relaxed);
+    }
+    return size;
+}
+
+void hashtable_concurrent_reclaim(hashtable_concurrent *tbl) {
+    for (int i = 0; i < tbl->nshards; i++) {
+        struct shard *sh = &tbl->shards[i];
+        while (sh->retired != NULL) {
+            struct cslots *s = sh->retired;
+            sh->retired = s->retired;
+            free(s);
+        }
+        while (sh->dead != NULL) {
+            struct key_copy *copy = sh->dead;
+            sh->dead = copy->next;
+            free(copy);
+        }
+    }
+}
+
+void hashtable_concurrent_kill(hashtable_concurrent *tbl) {
+    hashtable_concurrent_reclaim(tbl);
+    for (int i = 0; i < tbl->nshards; i++) {
+        struct shard *sh = &tbl->shards[i];
+        struct cslots *s = atomic_load(&sh->slots);
+        for (size_t idx = 0; s != NULL && idx <= s->mask; idx++) {
+            if (atomic_load(&s->slot[idx].hash) > HASH_REMOVED) {
+                free(copy_of(atomic_load(&s->slot[idx].key)));
+            }
+        }
+        free(s);
+        pthread_mutex_destroy(&sh->lock);
+    }
+    free(tbl->shards);
+    free(tbl);
+}
@@ -0,0 +1,998 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "hashtable.h"
+#include "int_hashtable.h"
+#include "hashtable_template.h"
+
+/*
+ * Test program for the hashtable implementation in hashtable.c.
+ * Each test prints an error message to stderr and exits via exit()
+ * with an error signal if it fails.
+ */
+
+/*
+ * Verify that the built-in hash is deterministic for a given seed,
+ * depends on the seed and accepts the empty key.
+ */
+void hash_seed_test()
+{
+    const char *key = "hashtable";
+    uint64_t h1 = hashtable_hash_bytes(key, strlen(key), 1);
+    uint64_t h2 = hashtable_hash_bytes(key, strlen(key), 1);
+    uint64_t h3 = hashtable_hash_bytes(key, strlen(key), 2);
+
+    if (h1 != h2) {
+        fprintf(stderr, "FAIL: Same key and seed gave different hashes!\n");
+        exit(EXIT_FAILURE);
+    }
+    if (h1 == h3) {
+        fprintf(stderr, "FAIL: Hash does not depend on the seed!\n");
+        exit(EXIT_FAILURE);
+    }
+    if (hashtable_hash_bytes("", 0, 1) == hashtable_hash_bytes("", 0, 2)) {
+        fprintf(stderr, "FAIL: Empty key hash does not depend on seed!\n");
+        exit(EXIT_FAILURE);
+    }
+
+    hashtable *tbl = hashtable_empty(100);
+    int idx = hashtable_hash(tbl, "");
+    if (idx < 0 || idx >= 100) {
+        fprintf(stderr, "FAIL: Empty key hashed to slot %d!\n", idx);
+        exit(EXIT_FAILURE);
+    }
+    hashtable_kill(tbl);
+}
+
+/*
+ * Verify that anagrams, which all collided under the old
+ * character-sum hash, are spread over the table.
+ */
+void anagram_spread_test()
+{
+    const char *words[] = { "abcd", "abdc", "acbd", "acdb", "adbc", "adcb",
+                            "bacd", "badc", "bcad", "bcda", "bdac", "bdca" };
+    int n = sizeof(words) / sizeof(words[0]);
+    hashtable *tbl = hashtable_empty(1024);
+    int distinct = 0;
+
+    for (int i = 0; i < n; i++) {
+        int seen = 0;
+        for (int j = 0; j < i; j++) {
+            if (hashtable_hash(tbl, (char *)words[i])
+                == hashtable_hash(tbl, (char *)words[j])) {
+                seen = 1;
+            }
+        }
+        distinct += !seen;
+    }
+    if (distinct < n - 2) {
+        fprintf(stderr, "FAIL: %d anagrams share only %d home slots!\n",
+                n, distinct);
+        exit(EXIT_FAILURE);
+    }
+    hashtable_kill(tbl);
+}
+
+// Hash callback that sends every key to the same slot.
+static uint64_t constant_hash(const void *key, size_t len, uint64_t seed)
+{
+    (void)key;
+    (void)len;
+    (void)seed;
+    return 7;
+}
+
+/*
+ * Verify that a user hash callback and seed given at creation are used.
+ */
+void custom_hash_test()
+{
+    hashtable_config cfg = { .capacity = 100, .hash_func = constant_hash,
+                             .seed = 42 };
+    hashtable *tbl = hashtable_create(&cfg);
+
+    if (hashtable_hash(tbl, "a") != 7 || hashtable_hash(tbl, "b") != 7) {
+        fprintf(stderr, "FAIL: Custom hash function was not used!\n");
+        exit(EXIT_FAILURE);
+    }
+    hashtable_kill(tbl);
+}
+
+// Create n distinct keys "key0", "key1", ...
+static char **make_keys(int n)
+{
+    char **keys = malloc(n * sizeof(*keys));
+    for (int i = 0; i < n; i++) {
+        keys[i] = malloc(16);
+        snprintf(keys[i], 16, "key%d", i);
+    }
+    return keys;
+}
+
+static void free_keys(char **keys, int n)
+{
+    for (int i = 0; i < n; i++) {
+        free(keys[i]);
+    }
+    free(keys);
+}
+
+/*
+ * Verify that a table created small grows to hold many keys and that
+ * every key can be found after each insert, both with rehashing at
+ * once and incrementally.
+ */
+void grow_test(hashtable_layout layout, bool incremental)
+{
+    int n = 5000;
+    char **keys = make_keys(n);
+    hashtable_config cfg = { .capacity = 4, .incremental = incremental,
+                             .layout = layout };
+    hashtable *tbl = hashtable_create(&cfg);
+
+    for (int i = 0; i < n; i++) {
+        hashtable_insert(tbl, keys[i]);
+        // Check old and new keys while a migration may be running.
+        int probe[] = { i, i / 2, i / 3 };
+        for (int p = 0; p < 3; p++) {
+            int j = probe[p];
+            if (hashtable_lookup(tbl, keys[j]) < 0) {
+                fprintf(stderr, "FAIL: Key %s lost after %d inserts!\n",
+                        keys[j], i + 1);
+                exit(EXIT_FAILURE);
+            }
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        if (hashtable_lookup(tbl, keys[i]) < 0) {
+            fprintf(stderr, "FAIL: Key %s not found!\n", keys[i]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    hashtable_kill(tbl);
+    free_keys(keys, n);
+}
+
+/*
+ * Verify that values stored with put can be read back with get, that
+ * put replaces the value of a present key and that get_or_insert only
+ * stores its value for missing keys.
+ */
+void put_get_test()
+{
+    int n = 1000;
+    char **keys = make_keys(n);
+    int *values = malloc(n * sizeof(*values));
+    hashtable *tbl = hashtable_empty(8);
+
+    for (int i = 0; i < n; i++) {
+        values[i] = i;
+        hashtable_put(tbl, keys[i], &values[i]);
+    }
+    hashtable_put(tbl, keys[0], &values[1]);
+    for (int i = 1; i < n; i++) {
+        int *v = hashtable_get(tbl, keys[i]);
+        if (v == NULL || *v != i) {
+            fprintf(stderr, "FAIL: Wrong value for key %s!\n", keys[i]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (hashtable_get(tbl, keys[0]) != &values[1]) {
+        fprintf(stderr, "FAIL: put did not replace the value!\n");
+        exit(EXIT_FAILURE);
+    }
+    if (hashtable_get(tbl, "missing") != NULL) {
+        fprintf(stderr, "FAIL: Missing key has a value!\n");
+        exit(EXIT_FAILURE);
+    }
+    if (hashtable_get_or_insert(tbl, keys[2], &values[3]) != &values[2]) {
+        fprintf(stderr, "FAIL: get_or_insert replaced a value!\n");
+        exit(EXIT_FAILURE);
+    }
+    char *extra = "extra";
+    if (hashtable_get_or_insert(tbl, extra, &values[3]) != &values[3]
+        || hashtable_get(tbl, extra) != &values[3]) {
+        fprintf(stderr, "FAIL: get_or_insert did not add a missing key!\n");
+        exit(EXIT_FAILURE);
+    }
+    hashtable_kill(tbl);
+    free(values);
+    free_keys(keys, n);
+}
+
+/*
+ * Verify that keys are found by content, not by pointer identity.
+ */
+void key_content_test()
+{
+    int n = 500;
+    char **keys = make_keys(n);
+    char **copies = make_keys(n);
+    hashtable *tbl = hashtable_empty(8);
+
+    for (int i = 0; i < n; i++) {
+        hashtable_put(tbl, keys[i], keys[i]);
+    }
+    for (int i = 0; i < n; i++) {
+        if (hashtable_get(tbl, copies[i]) != keys[i]
+            || hashtable_lookup(tbl, copies[i]) < 0) {
+            fprintf(stderr, "FAIL: Copy of key %s not found!\n", keys[i]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    hashtable_put(tbl, copies[0], copies[0]);
+    if (hashtable_get(tbl, keys[0]) != copies[0]) {
+        fprintf(stderr, "FAIL: Copy of a key was added twice!\n");
+        exit(EXIT_FAILURE);
+    }
+    hashtable_kill(tbl);
+    free_keys(copies, n);
+    free_keys(keys, n);
+}
+
+/*
+ * Verify that removed keys are gone, that the remaining keys stay
+ * reachable across wrapped probe chains, and that long insert/remove
+ * churn does not lose keys.
+ */
+void remove_test(hashtable_layout layout, bool incremental)
+{
+    int n = 2000;
+    char **keys = make_keys(n);
+    hashtable_config cfg = { .capacity = 8, .incremental = incremental,
+                             .layout = layout };
+    hashtable *tbl = hashtable_create(&cfg);
+
+    for (int i = 0; i < n; i++) {
+        hashtable_put(tbl, keys[i], keys[i]);
+        // Remove every third key, sometimes mid-migration.
+        if (i % 3 == 2) {
+            hashtable_remove(tbl, keys[i - 1]);
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        char *v = hashtable_get(tbl, keys[i]);
+        bool removed = i % 3 == 1 && i < n - 1;
+        if (removed ? v != NULL : v != keys[i]) {
+            fprintf(stderr, "FAIL: Key %s %s after removals!\n", keys[i],
+                    removed ? "still present" : "lost");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // Churn: keep the key count constant while cycling through keys.
+    for (int round = 0; round < 20; round++) {
+        for (int i = 0; i < n; i += 3) {
+            hashtable_remove(tbl, keys[i]);
+            hashtable_put(tbl, keys[i], keys[i]);
+        }
+    }
+    for (int i = 0; i < n; i += 3) {
+        if (hashtable_get(tbl, keys[i]) != keys[i]) {
+            fprintf(stderr, "FAIL: Key %s lost during churn!\n", keys[i]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    hashtable_remove(tbl, "missing");
+    hashtable_kill(tbl);
+    free_keys(keys, n);
+}
+
+/*
+ * Verify the PSL statistics, and that robin hood placement keeps the
+ * longest PSL no longer than plain linear probing for the same keys,
+ * seed and capacity.
+ */
+void robin_hood_psl_test()
+{
+    int n = 3000;
+    char **keys = make_keys(n);
+    hashtable_config cfg = { .capacity = 4096, .seed = 4711,
+                             .max_load = 0.9 };
+    hashtable *linear = hashtable_create(&cfg);
+    cfg.layout = HASHTABLE_ROBIN_HOOD;
+    hashtable *robin = hashtable_create(&cfg);
+    struct hashtable_stats ls, rs;
+
+    for (int i = 0; i < n; i++) {
+        hashtable_insert(linear, keys[i]);
+        hashtable_insert(robin, keys[i]);
+    }
+    hashtable_stats(linear, &ls);
+    hashtable_stats(robin, &rs);
+    if (rs.size != n || rs.capacity != 4096) {
+        fprintf(stderr, "FAIL: Stats report %d keys in %d slots!\n",
+                rs.size, rs.capacity);
+        exit(EXIT_FAILURE);
+    }
+    // Both place the same keys along the same chains, so the PSL sum
+    // and thus the mean are equal. Only the spread differs.
+    if (rs.max_psl > ls.max_psl || rs.mean_psl > ls.mean_psl + 1e-9) {
+        fprintf(stderr, "FAIL: Robin hood PSL max %d mean %.2f, linear "
+                "max %d mean %.2f!\n", rs.max_psl, rs.mean_psl,
+                ls.max_psl, ls.mean_psl);
+        exit(EXIT_FAILURE);
+    }
+    hashtable_kill(linear);
+    hashtable_kill(robin);
+    free_keys(keys, n);
+}
+
+/*
+ * Verify that the batch calls give the same results as put and get in
+ * every layout, over batches larger than the prefetch window and while
+ * an incremental migration is running.
+ */
+void batch_test()
+{
+    int n = 3000;
+    char **keys = make_keys(n);
+    void **values = malloc(n * sizeof(*values));
+    hashtable_layout layouts[] = { HASHTABLE_LINEAR, HASHTABLE_SWISS,
+                                   HASHTABLE_ROBIN_HOOD };
+
+    for (int l = 0; l < 3; l++) {
+        hashtable_config cfg = { .capacity = 8, .incremental = true,
+                                 .layout = layouts[l] };
+        hashtable *tbl = hashtable_create(&cfg);
+
+        // Store the first half of the keys, then clear the values of
+        // the first hundred.
+        for (int i = 0; i < n; i++) {
+            values[i] = keys[i];
+        }
+        hashtable_insert_many(tbl, keys, values, n / 2);
+        hashtable_insert_many(tbl, keys, NULL, 100);
+        if (hashtable_get(tbl, keys[0]) != NULL
+            || hashtable_get(tbl, keys[100]) != keys[100]) {
+            fprintf(stderr, "FAIL: insert_many did not replace values!\n");
+            exit(EXIT_FAILURE);
+        }
+
+        int found = hashtable_lookup_many(tbl, keys, n, values);
+        if (found != n / 2) {
+            fprintf(stderr, "FAIL: lookup_many found %d of %d keys!\n",
+                    found, n / 2);
+            exit(EXIT_FAILURE);
+        }
+        for (int i = 0; i < n; i++) {
+            if (values[i] != hashtable_get(tbl, keys[i])) {
+                fprintf(stderr, "FAIL: lookup_many and get disagree on "
+                        "key %s!\n", keys[i]);
+                exit(EXIT_FAILURE);
+            }
+        }
+        hashtable_kill(tbl);
+    }
+    free(values);
+    free_keys(keys, n);
+}
+
+/*
+ * Verify that a table with copy_keys set finds its keys after the
+ * caller's buffer is reused, and keeps them through removals, grows
+ * and rebuilds of the key arena.
+ */
+void copy_keys_test(bool incremental)
+{
+    int n = 2000;
+    char **keys = make_keys(n);
+    char buf[16];
+    hashtable_config cfg = { .capacity = 8, .copy_keys = true,
+                             .incremental = incremental };
+    hashtable *tbl = hashtable_create(&cfg);
+
+    for (int i = 0; i < n; i++) {
+        snprintf(buf, sizeof(buf), "key%d", i);
+        hashtable_put(tbl, buf, keys[i]);
+    }
+    memset(buf, 0, sizeof(buf));
+
+    // Remove and re-add most keys, so the arena fills with removed
+    // copies, and grow the table past them.
+    for (int round = 0; round < 5; round++) {
+        for (int i = 0; i < n; i++) {
+            if (i % 4 != 0) {
+                hashtable_remove(tbl, keys[i]);
+                snprintf(buf, sizeof(buf), "key%d", i);
+                hashtable_put(tbl, buf, keys[i]);
+            }
+        }
+    }
+    for (int i = n; i < 4 * n; i++) {
+        snprintf(buf, sizeof(buf), "key%d", i);
+        hashtable_insert(tbl, buf);
+    }
+    for (int i = 0; i < n; i++) {
+        if (hashtable_get(tbl, keys[i]) != keys[i]) {
+            fprintf(stderr, "FAIL: Copied key %s lost!\n", keys[i]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    hashtable_kill(tbl);
+    free_keys(keys, n);
+}
+
+/*
+ * Verify the load, PSL histogram, cluster, size and counter statistics
+ * against what a small workload must produce.
+ */
+void stats_test()
+{
+    int n = 1000;
+    char **keys = make_keys(n);
+    hashtable_config cfg = { .capacity = 16, .layout = HASHTABLE_SWISS };
+    hashtable *tbl = hashtable_create(&cfg);
+    struct hashtable_stats st;
+
+    for (int i = 0; i < n; i++) {
+        hashtable_insert(tbl, keys[i]);
+    }
+    for (int i = 0; i < n; i++) {
+        hashtable_get(tbl, keys[i]);
+    }
+    hashtable_get(tbl, "missing");
+    hashtable_lookup(tbl, "missing");
+    hashtable_stats(tbl, &st);
+
+    int counted = 0;
+    for (int b = 0; b < HASHTABLE_PSL_BUCKETS; b++) {
+        counted += st.psl_hist[b];
+    }
+    if (counted != n || st.load != (double)n / st.capacity) {
+        fprintf(stderr, "FAIL: Histogram holds %d of %d keys, load %.3f!\n",
+                counted, n, st.load);
+        exit(EXIT_FAILURE);
+    }
+    if (st.max_cluster < 1 || st.max_cluster >= st.capacity) {
+        fprintf(stderr, "FAIL: Longest cluster %d of %d slots!\n",
+                st.max_cluster, st.capacity);
+        exit(EXIT_FAILURE);
+    }
+    if (st.bytes < (size_t)st.capacity * 3 * sizeof(void *)) {
+        fprintf(stderr, "FAIL: %zu bytes for %d slots!\n", st.bytes,
+                st.capacity);
+        exit(EXIT_FAILURE);
+    }
+#ifndef HASHTABLE_NO_STATS
+    // Growing from 16 to 2048 slots takes 7 doublings.
+    if (st.hits != n || st.misses != 2 || st.resizes != 7) {
+        fprintf(stderr, "FAIL: Counted %ld hits, %ld misses, %ld resizes!\n",
+                st.hits, st.misses, st.resizes);
+        exit(EXIT_FAILURE);
+    }
+#endif
+    hashtable_kill(tbl);
+    free_keys(keys, n);
+}
+
+/*
+ * Verify the integer-keyed table with consecutive and spread keys, the
+ * out-of-band zero key, replaced values and removals across grows.
+ */
+void int_hashtable_test()
+{
+    int n = 5000;
+    int_hashtable *tbl = int_hashtable_create(4);
+    int *values = malloc(n * sizeof(*values));
+
+    // Keys i and i << 40 for each i. Both give the key 0 for i = 0.
+    for (int i = 0; i < n; i++) {
+        values[i] = i;
+        int_hashtable_put(tbl, i, &values[i]);
+        int_hashtable_put(tbl, (uint64_t)i << 40, &values[i]);
+    }
+    int_hashtable_put(tbl, UINT64_MAX, NULL);
+    if (int_hashtable_size(tbl) != 2 * n || !int_hashtable_has_key(tbl, 0)
+        || !int_hashtable_has_key(tbl, UINT64_MAX)
+        || int_hashtable_get(tbl, UINT64_MAX) != NULL) {
+        fprintf(stderr, "FAIL: Table holds %d keys, expected %d!\n",
+                int_hashtable_size(tbl), 2 * n);
+        exit(EXIT_FAILURE);
+    }
+
+    // Remove the even small keys, 0 included, and replace one value.
+    for (int i = 0; i < n; i += 2) {
+        int_hashtable_remove(tbl, i);
+    }
+    int_hashtable_put(tbl, (uint64_t)1 << 40, &values[0]);
+    for (int i = 1; i < n; i++) {
+        int *v = int_hashtable_get(tbl, i);
+        int *w = int_hashtable_get(tbl, (uint64_t)i << 40);
+        if ((i % 2 == 0 ? v != NULL : v != &values[i])
+            || w != &values[i == 1 ? 0 : i]) {
+            fprintf(stderr, "FAIL: Wrong value for key %d!\n", i);
+            exit(EXIT_FAILURE);
+        }
+    }
+    int_hashtable_remove(tbl, 123456789);
+    if (int_hashtable_has_key(tbl, 0)
+        || int_hashtable_size(tbl) != n + n / 2) {
+        fprintf(stderr, "FAIL: %d keys left after removals!\n",
+                int_hashtable_size(tbl));
+        exit(EXIT_FAILURE);
+    }
+    int_hashtable_kill(tbl);
+    free(values);
+}
+
+/*
+ * Verify that a saved image maps back with every key and value, in
+ * the middle of an incremental migration, that damage is caught by
+ * the checksum or the header checks, and that tables with a custom
+ * hash are refused.
+ */
+void image_test()
+{
+    const char *path = "hashtable_test.img";
+    int n = 3000;
+    char **keys = make_keys(n);
+    hashtable_config cfg = { .capacity = 8, .incremental = true };
+    hashtable *tbl = hashtable_create(&cfg);
+
+    for (int i = 0; i < n; i++) {
+        hashtable_put(tbl, keys[i], (void *)(uintptr_t)(i + 1));
+    }
+    hashtable_put(tbl, "", NULL);
+    if (hashtable_save(tbl, path) < 0) {
+        fprintf(stderr, "FAIL: Could not save the image!\n");
+        exit(EXIT_FAILURE);
+    }
+    hashtable_kill(tbl);
+
+    hashtable_image *img = hashtable_open_mmap(path);
+    uint64_t v;
+    if (img == NULL || hashtable_image_size(img) != n + 1
+        || !hashtable_image_verify(img)) {
+        fprintf(stderr, "FAIL: Saved image did not open and verify!\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < n; i++) {
+        if (!hashtable_image_get(img, keys[i], &v) || v != (uint64_t)i + 1) {
+            fprintf(stderr, "FAIL: Key %s missing from image!\n", keys[i]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (!hashtable_image_get(img, "", &v) || v != 0
+        || hashtable_image_get(img, "missing", NULL)) {
+        fprintf(stderr, "FAIL: Image lookups of edge keys failed!\n");
+        exit(EXIT_FAILURE);
+    }
+    hashtable_image_close(img);
+
+    // Flip the last key byte: the header still checks out, the
+    // checksum does not.
+    FILE *f = fopen(path, "r+b");
+    fseek(f, -2, SEEK_END);
+    int c = fgetc(f);
+    fseek(f, -2, SEEK_END);
+    fputc(c ^ 1, f);
+    fclose(f);
+    img = hashtable_open_mmap(path);
+    if (img == NULL || hashtable_image_verify(img)) {
+        fprintf(stderr, "FAIL: Damaged image passed verification!\n");
+        exit(EXIT_FAILURE);
+    }
+    hashtable_image_close(img);
+
+    // A truncated file fails the header checks.
+    f = fopen(path, "wb");
+    fputs("HASHIMG1", f);
+    fclose(f);
+    if (hashtable_open_mmap(path) != NULL) {
+        fprintf(stderr, "FAIL: Truncated image was opened!\n");
+        exit(EXIT_FAILURE);
+    }
+    remove(path);
+
+    hashtable_config custom = { .hash_func = constant_hash };
+    tbl = hashtable_create(&custom);
+    if (hashtable_save(tbl, path) == 0) {
+        fprintf(stderr, "FAIL: Table with a custom hash was saved!\n");
+        exit(EXIT_FAILURE);
+    }
+    hashtable_kill(tbl);
+    free_keys(keys, n);
+}
+
+/*
+ * Verify that hashtable_build gives the same table as putting the keys
+ * one by one, duplicates included, in every layout. The threaded builds
+ * run at a high load, so keys run past the end of their thread's slots.
+ * Also verify that a build from no keys gives an empty table.
+ */
+void build_test()
+{
+    int n = 300000;
+    int m = n + n / 3;
+    char **keys = make_keys(n);
+    char **input = malloc(m * sizeof(*input));
+    void **values = malloc(m * sizeof(*values));
+    struct {
+        hashtable_layout layout;
+        int threads;
+        bool copy_keys;
+    } builds[] = {
+        { HASHTABLE_LINEAR, 1, false },
+        { HASHTABLE_LINEAR, 4, false },
+        { HASHTABLE_LINEAR, 4, true },
+        { HASHTABLE_SWISS, 4, false },
+        { HASHTABLE_ROBIN_HOOD, 4, false },
+    };
+
+    // Every third key comes again later with a new value.
+    for (int i = 0; i < n; i++) {
+        input[i] = keys[i];
+        values[i] = keys[i];
+    }
+    for (int j = 0; j < n / 3; j++) {
+        input[n + j] = keys[3 * j];
+        values[n + j] = keys[3 * j + 1];
+    }
+
+    for (int b = 0; b < 5; b++) {
+        hashtable_config cfg = { .max_load = 0.95,
+                                 .layout = builds[b].layout,
+                                 .build_threads = builds[b].threads,
+                                 .copy_keys = builds[b].copy_keys };
+        hashtable *tbl = hashtable_build(&cfg, input, values, m);
+        struct hashtable_stats st;
+
+        hashtable_stats(tbl, &st);
+        if (st.size != n || st.resizes != 0) {
+            fprintf(stderr, "FAIL: build %d stored %d keys with %ld "
+                    "resizes!\n", b, st.size, st.resizes);
+            exit(EXIT_FAILURE);
+        }
+        for (int i = 0; i < n; i++) {
+            void *expected = i % 3 == 0 ? keys[i + 1] : keys[i];
+            if (hashtable_get(tbl, keys[i]) != expected) {
+                fprintf(stderr, "FAIL: build %d has the wrong value for "
+                        "key %s!\n", b, keys[i]);
+                exit(EXIT_FAILURE);
+            }
+        }
+        hashtable_kill(tbl);
+    }
+
+    // An empty input gives an empty table.
+    hashtable_config cfg = { .layout = HASHTABLE_LINEAR,
+                             .build_threads = 4 };
+    hashtable *tbl = hashtable_build(&cfg, input, values, 0);
+    struct hashtable_stats st;
+    if (tbl != NULL) {
+        hashtable_stats(tbl, &st);
+    }
+    if (tbl == NULL || st.size != 0) {
+        fprintf(stderr, "FAIL: build from no keys did not give an empty "
+                "table!\n");
+        exit(EXIT_FAILURE);
+    }
+    hashtable_kill(tbl);
+
+    free(values);
+    free(input);
+    free_keys(keys, n);
+}
+
+/*
+ * Verify that an iterator visits every key once and that draining
+ * hands over every key and empties the table, in every layout and
+ * while an incremental migration is running.
+ */
+void iter_test(bool copy_keys)
+{
+    // The last grow, at 3072 keys, is still migrating.
+    int n = 3100;
+    char **keys = make_keys(n);
+    char *seen = malloc(n);
+    hashtable_layout layouts[] = { HASHTABLE_LINEAR, HASHTABLE_SWISS,
+                                   HASHTABLE_ROBIN_HOOD };
+
+    for (int l = 0; l < 3; l++) {
+        hashtable_config cfg = { .capacity = 8, .incremental = true,
+                                 .layout = layouts[l],
+                                 .copy_keys = copy_keys };
+        hashtable *tbl = hashtable_create(&cfg);
+        hashtable_iter it;
+        char *key;
+        void *value;
+
+        // Values point into seen, so each visit can be checked off.
+        for (int i = 0; i < n; i++) {
+            hashtable_put(tbl, keys[i], seen + i);
+        }
+        memset(seen, 0, n);
+        hashtable_iter_begin(tbl, &it);
+        while (hashtable_iter_next(&it, &key, &value)) {
+            int i = (char *)value - seen;
+            if (strcmp(key, keys[i]) != 0 || seen[i]++) {
+                fprintf(stderr, "FAIL: Iterator visited %s wrongly!\n",
+                        key);
+                exit(EXIT_FAILURE);
+            }
+        }
+        if (memchr(seen, 0, n) != NULL) {
+            fprintf(stderr, "FAIL: Iterator missed a key!\n");
+            exit(EXIT_FAILURE);
+        }
+
+        memset(seen, 0, n);
+        hashtable_iter_begin(tbl, &it);
+        while (hashtable_iter_drain(&it, &key, &value)) {
+            int i = (char *)value - seen;
+            if (strcmp(key, keys[i]) != 0 || seen[i]++) {
+                fprintf(stderr, "FAIL: Drain handed over %s wrongly!\n",
+                        key);
+                exit(EXIT_FAILURE);
+            }
+        }
+        struct hashtable_stats st;
+        hashtable_stats(tbl, &st);
+        if (memchr(seen, 0, n) != NULL || st.size != 0) {
+            fprintf(stderr, "FAIL: Drain left %d keys!\n", st.size);
+            exit(EXIT_FAILURE);
+        }
+
+        // The drained table is usable again.
+        hashtable_put(tbl, keys[0], keys[0]);
+        if (hashtable_get(tbl, keys[0]) != keys[0]
+            || hashtable_get(tbl, keys[1]) != NULL) {
+            fprintf(stderr, "FAIL: Drained table lookups are wrong!\n");
+            exit(EXIT_FAILURE);
+        }
+        hashtable_kill(tbl);
+    }
+    free(seen);
+    free_keys(keys, n);
+}
+
+static inline uint64_t u32_hash(uint32_t k)
+{
+    return k;
+}
+
+#define U32_EQ(a, b) ((a) == (b))
+
+HASHTABLE_DEFINE(u32_map, uint32_t, uint32_t, u32_hash, U32_EQ)
+
+// A small POD key, compared member by member.
+struct point {
+    int x;
+    int y;
+};
+
+static inline uint64_t point_hash(struct point p)
+{
+    return hashtable_hash_bytes(&p, sizeof(p), 1);
+}
+
+static inline bool point_eq(struct point a, struct point b)
+{
+    return a.x == b.x && a.y == b.y;
+}
+
+HASHTABLE_DEFINE(point_map, struct point, double, point_hash, point_eq)
+
+/*
+ * Verify tables generated from the template with an integer key that
+ * includes 0, and with a struct key.
+ */
+void template_test()
+{
+    int n = 5000;
+    u32_map *m = u32_map_create(0);
+    point_map *pm = point_map_create(4);
+
+    for (uint32_t i = 0; i < (uint32_t)n; i++) {
+        u32_map_put(m, i * 3, i);
+        point_map_put(pm, (struct point){ i, -i }, i / 2.0);
+    }
+    for (uint32_t i = 0; i < (uint32_t)n; i += 2) {
+        u32_map_remove(m, i * 3);
+    }
+    u32_map_put(m, 3, 7);
+    for (uint32_t i = 0; i < (uint32_t)n; i++) {
+        uint32_t *v = u32_map_get(m, i * 3);
+        bool removed = i % 2 == 0;
+        if (removed ? v != NULL : v == NULL || *v != (i == 1 ? 7 : i)) {
+            fprintf(stderr, "FAIL: Wrong u32_map value for key %u!\n",
+                    i * 3);
+            exit(EXIT_FAILURE);
+        }
+        double *d = point_map_get(pm, (struct point){ i, -i });
+        if (d == NULL || *d != i / 2.0) {
+            fprintf(stderr, "FAIL: Wrong point_map value for (%u, -%u)!\n",
+                    i, i);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (u32_map_get(m, 1) != NULL || u32_map_size(m) != n / 2
+        || point_map_get(pm, (struct point){ 1, 1 }) != NULL
+        || point_map_size(pm) != n) {
+        fprintf(stderr, "FAIL: Template tables hold %d and %d keys!\n",
+                u32_map_size(m), point_map_size(pm));
+        exit(EXIT_FAILURE);
+    }
+    u32_map_kill(m);
+    point_map_kill(pm);
+}
+
+struct concurrent_worker {
+    pthread_t thread;
+    hashtable_concurrent *tbl;
+    char **keys;
+    int first;          // First key owned by this writer.
+    int n;              // Number of keys per writer.
+    bool writer;
+};
+
+// Writers put, remove and re-put their own keys. Readers look up keys
+// of all writers and check that any value found belongs to the key.
+static void *concurrent_worker(void *arg)
+{
+    struct concurrent_worker *w = arg;
+
+    for (int round = 0; round < 20; round++) {
+        for (int i = w->first; i < w->first + w->n; i++) {
+            if (w->writer) {
+                hashtable_concurrent_put(w->tbl, w->keys[i], w->keys[i]);
+                if (round % 2 == 1) {
+                    hashtable_concurrent_remove(w->tbl, w->keys[i]);
+                    hashtable_concurrent_put(w->tbl, w->keys[i], w->keys[i]);
+                }
+            } else {
+                char *v = hashtable_concurrent_get(w->tbl, w->keys[i]);
+                if (v != NULL && v != w->keys[i]) {
+                    fprintf(stderr, "FAIL: Key %s read value %s!\n",
+                            w->keys[i], v);
+                    exit(EXIT_FAILURE);
+                }
+            }
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Verify the concurrent table single-threaded, then with writer and
+ * reader threads sharing it.
+ */
+void concurrent_test()
+{
+    int writers = 4, per_writer = 2000, n = writers * per_writer;
+    char **keys = make_keys(n);
+    char **copies = make_keys(n);
+    hashtable_concurrent *tbl = hashtable_concurrent_create(8, NULL);
+
+    hashtable_concurrent_put(tbl, keys[0], keys[1]);
+    hashtable_concurrent_put(tbl, keys[0], keys[0]);
+    if (hashtable_concurrent_get(tbl, copies[0]) != keys[0]
+        || hashtable_concurrent_size(tbl) != 1) {
+        fprintf(stderr, "FAIL: Concurrent put did not replace the value!\n");
+        exit(EXIT_FAILURE);
+    }
+    hashtable_concurrent_remove(tbl, copies[0]);
+    if (hashtable_concurrent_get(tbl, keys[0]) != NULL) {
+        fprintf(stderr, "FAIL: Removed key still present!\n");
+        exit(EXIT_FAILURE);
+    }
+
+    struct concurrent_worker w[8];
+    for (int i = 0; i < 8; i++) {
+        w[i] = (struct concurrent_worker) {
+            .tbl = tbl, .keys = keys, .first = (i % writers) * per_writer,
+            .n = per_writer, .writer = i < writers
+        };
+        pthread_create(&w[i].thread, NULL, concurrent_worker, &w[i]);
+    }
+    for (int i = 0; i < 8; i++) {
+        pthread_join(w[i].thread, NULL);
+    }
+    hashtable_concurrent_reclaim(tbl);
+    for (int i = 0; i < n; i++) {
+        if (hashtable_concurrent_get(tbl, copies[i]) != keys[i]) {
+            fprintf(stderr, "FAIL: Key %s lost by concurrent writers!\n",
+                    keys[i]);
+            exit(EXIT_FAILURE);
+        }
+    }
+    if (hashtable_concurrent_size(tbl) != n) {
+        fprintf(stderr, "FAIL: Concurrent size %d, expected %d!\n",
+                hashtable_concurrent_size(tbl), n);
+        exit(EXIT_FAILURE);
+    }
+    hashtable_concurrent_kill(tbl);
+    free_keys(copies, n);
+    free_keys(keys, n);
+}
+
+int main(void)
+{
+    fprintf(stderr, "Running TEST1: hash_seed_test(): ");
+    hash_seed_test();
+    fprintf(stderr, "OK.\n");
+    fprintf(stderr, "Running TEST2: anagram_spread_test(): ");
+    anagram_spread_test();
+    fprintf(stderr, "OK.\n");
+    fprintf(stderr, "Running TEST3: custom_hash_test(): ");
+    custom_hash_test();
+    fprintf(stderr, "OK.\n");
+    fprintf(stderr, "Running TEST4: grow_test(LINEAR, false): ");
+    grow_test(HASHTABLE_LINEAR, false);
+    fprintf(stderr, "OK.\n");
+    fprintf(stderr, "Running TEST5: grow_test(LINEAR, true): ");
+    grow_test(HASHTABLE_LINEAR, true);
+    fprintf(stderr, "OK.\n");
+    fprintf(stderr, "Running TEST6: put_get_test(): ");
+    put_get_test();
+    fprintf(stderr, "OK.\n");
+    fprintf(stderr, "Running TEST7: key_content_test(): ");
+    key_content_test();
+    fprintf(stderr, "OK.\n");
+    fprintf(stderr, "Running TEST8: remove_test(LINEAR, false): ");
+    remove_test(HASHTABLE_LINEAR, false);
+    fprintf(stderr, "OK.\n");
+    fprintf(stderr, "Running TEST9: remove_test(LINEAR, true): ");
+    remove_test(HASHTABLE_LINEAR, true);
+    fprintf(stderr, "OK.\n");
+    fprintf(stderr, "Running TEST10: grow_test(SWISS, false): ");
+    grow_test(HASHTABLE_SWISS, false);
+    fprintf(stderr, "OK.\n");
+    fprintf(stderr, "Running TEST11: grow_test(SWISS, true): ");
+    grow_test(HASHTABLE_SWISS, true);
+    fprintf(stderr, "OK.\n");
+    fprintf(stderr, "Running TEST12: remove_test(SWISS, false): ");
+    remove_test(HASHTABLE_SWISS, false);
+    fprintf(stderr, "OK.\n");
+    fprintf(stderr, "Running TEST13: remove_test(SWISS, true): ");
+    remove_test(HASHTABLE_SWISS, true);
+    fprintf(stderr, "OK.\n");
+    fprintf(stderr, "Running TEST14: grow_test(ROBIN_HOOD, true): ");
+    grow_test(HASHTABLE_ROBIN_HOOD, true);
+    fprintf(stderr, "OK.\n");
+    fprintf(stderr, "Running TEST15: remove_test(ROBIN_HOOD, true): ");
+    remove_test(HASHTABLE_ROBIN_HOOD, true);
+    fprintf(stderr, "OK.\n");
+    fprintf(stderr, "Running TEST16: robin_hood_psl_test(): ");
+    robin_hood_psl_test();
+    fprintf(stderr, "OK.\n");
+    fprintf(stderr, "Running TEST17: concurrent_test(): ");
+    concurrent_test();
+    fprintf(stderr, "OK.\n");
+    fprintf(stderr, "Running TEST18: batch_test(): ");
+    batch_test();
+    fprintf(stderr, "OK.\n");
+    fprintf(stderr, "Running TEST19: copy_keys_test(false): ");
+    copy_keys_test(false);
+    fprintf(stderr, "OK.\n");
+    fprintf(stderr, "Running TEST20: copy_keys_test(true): ");
+    copy_keys_test(true);
+    fprintf(stderr, "OK.\n");
+    fprintf(stderr, "Running TEST21: stats_test(): ");
+    stats_test();
+    fprintf(stderr, "OK.\n");
+    fprintf(stderr, "Running TEST22: int_hashtable_test(): ");
+    int_hashtable_test();
+    fprintf(stderr, "OK.\n");
+    fprintf(stderr, "Running TEST23: template_test(): ");
+    template_test();
+    fprintf(stderr, "OK.\n");
+    fprintf(stderr, "Running TEST24: image_test(): ");
+    image_test();
+    fprintf(stderr, "OK.\n");
+    fprintf(stderr, "Running TEST25: build_test(): ");
+    build_test();
+    fprintf(stderr, "OK.\n");
+    fprintf(stderr, "Running TEST26: iter_test(false): ");
+    iter_test(false);
+    fprintf(stderr, "OK.\n");
+    fprintf(stderr, "Running TEST27: iter_test(true): ");
+    iter_test(true);
+    fprintf(stderr, "OK.\n");
+
+    fprintf(stderr, "SUCCESS: Implementation passed all tests. Normal exit.\n");
+    return 0;
+}
@@ -0,0 +1,165 @@
+#include <stdlib.h>
+#include "int_hashtable.h"
+
+// 2^64 / phi, the multiplier of fibonacci hashing.
+#define FIB_MULT 0x9e3779b97f4a7c15ULL
+
+// Key of a free slot.
+#define KEY_FREE 0
+
+// Maximum load factor.
+#define INT_HASHTABLE_MAX_LOAD 0.75
+
+// Smallest number of slots.
+#define INT_HASHTABLE_MIN_CAPACITY 16
+
+// A slot. Key and value sit next to each other, so a hit reads one
+// cache line.
+struct int_slot {
+    uint64_t key;
+    void *value;
+};
+
+struct int_hashtable {
+    int size;           // Number of keys, zero key included.
+    int max;            // Number of slots, a power of two.
+    int shift;          // 64 - log2(max).
+    struct int_slot *slots;
+    bool has_zero;      // The key 0 is present.
+    void *zero_value;   // Value of the key 0.
+};
+
+// The top bits of key times 2^64 / phi. Consecutive keys land far
+// apart and every key bit affects the slot.
+static inline int home_slot(const int_hashtable *tbl, uint64_t key) {
+    return (int)((key * FIB_MULT) >> tbl->shift);
+}
+
+// Find the slot holding a nonzero key, or the free slot ending its
+// chain.
+static int find_slot(const int_hashtable *tbl, uint64_t key) {
+    int mask = tbl->max - 1;
+    int idx = home_slot(tbl, key);
+
+    while (tbl->slots[idx].key != key && tbl->slots[idx].key != KEY_FREE) {
+        idx = (idx + 1) & mask;
+    }
+    return idx;
+}
+
+static int set_capacity(int_hashtable *tbl, int max) {
+    struct int_slot *slots = calloc(max, sizeof(*slots));
+    if (slots == NULL) {
+        return -1;
+    }
+    struct int_slot *old = tbl->slots;
+    int old_max = tbl->max;
+
+    tbl->slots = slots;
+    tbl->max = max;
+    tbl->shift = 64;
+    while (max > 1) {
+        max /= 2;
+        tbl->shift--;
+    }
+    for (int i = 0; i < old_max; i++) {
+        if (old[i].key != KEY_FREE) {
+            tbl->slots[find_slot(tbl, old[i].key)] = old[i];
+        }
+    }
+    free(old);
+    return 0;
+}
+
+int_hashtable *int_hashtable_create(int capacity) {
+    int_hashtable *tbl = calloc(1, sizeof(*tbl));
+    if (tbl == NULL) {
+        return NULL;
+    }
+    int max = INT_HASHTABLE_MIN_CAPACITY;
+    while (max < capacity) {
+        max *= 2;
+    }
+    if (set_capacity(tbl, max) < 0) {
+        free(tbl);
+        return NULL;
+    }
+    return tbl;
+}
+
+int_hashtable *int_hashtable_put(int_hashtable *tbl, uint64_t key,
+                                 void *value) {
+    if (key == KEY_FREE) {
+        tbl->size += !tbl->has_zero;
+        tbl->has_zero = true;
+        tbl->zero_value = value;
+        return tbl;
+    }
+    int idx = find_slot(tbl, key);
+    if (tbl->slots[idx].key == key) {
+        tbl->slots[idx].value = value;
+        return tbl;
+    }
+    if (tbl->size + 1 > INT_HASHTABLE_MAX_LOAD * tbl->max) {
+        if (set_capacity(tbl, 2 * tbl->max) < 0) {
+            return NULL;
+        }
+        idx = find_slot(tbl, key);
+    }
+    tbl->slots[idx].key = key;
+    tbl->slots[idx].value = value;
+    tbl->size++;
+    return tbl;
+}
+
+void *int_hashtable_get(const int_hashtable *tbl, uint64_t key) {
+    if (key == KEY_FREE) {
+        return tbl->has_zero ? tbl->zero_value : NULL;
+    }
+    const struct int_slot *slot = &tbl->slots[find_slot(tbl, key)];
+    return slot->key == key ? slot->value : NULL;
+}
+
+bool int_hashtable_has_key(const int_hashtable *tbl, uint64_t key) {
+    if (key == KEY_FREE) {
+        return tbl->has_zero;
+    }
+    return tbl->slots[find_slot(tbl, key)].key == key;
+}
+
+int_hashtable *int_hashtable_remove(int_hashtable *tbl, uint64_t key) {
+    if (key == KEY_FREE) {
+        tbl->size -= tbl->has_zero;
+        tbl->has_zero = false;
+        tbl->zero_value = NULL;
+        return tbl;
+    }
+    int mask = tbl->max - 1;
+    int hole = find_slot(tbl, key);
+    if (tbl->slots[hole].key != key) {
+        return tbl;
+    }
+    // Shift back each later key of the chain whose home slot is not
+    // between the hole and its own slot.
+    for (int idx = (hole + 1) & mask; tbl->slots[idx].key != KEY_FREE;
+         idx = (idx + 1) & mask) {
+        int home = home_slot(tbl, tbl->slots[idx].key);
+        if (((idx - home) & mask) >= ((idx - hole) & mask)) {
+            tbl->slots[hole] = tbl->slots[idx];
+            hole = idx;
+        }
+    }
+    tbl->slots[hole].key = KEY_FREE;
+    tbl->slots[hole].value = NULL;
+    tbl->size--;
+    return tbl;
+}
+
+int int_hashtable_size(const int_hashtable *tbl) {
+    return tbl->size;
+}
+
+void int_hashtable_kill(int_hashtable *tbl) {
+    free(tbl->slots);
+    free(tbl);
+}